@@ -25,7 +25,8 @@ void Run(std::string& inputFilePath,
          std::string& parameterFile,
          std::string& outdir,
          bool enableTimeSuffix,
-         int seedOffset)
+         int seedOffset,
+         std::string& loadingCacheFile)
 {
     InputParameters inputParameters;
 
@@ -89,7 +90,8 @@ void Run(std::string& inputFilePath,
             std::cout << "Run: " << i << "\n";
             GRBEnv env = GRBEnv(outputPath + "/" + instance.Name + ".LOG");
             inputParameters.MIPSolver.Seed += i;
-            BranchAndCutSolver exactAlgorithm(&instance, &env, inputParameters, startSolutionPath, outputPath);
+            BranchAndCutSolver exactAlgorithm(
+                &instance, &env, inputParameters, startSolutionPath, outputPath, loadingCacheFile);
             exactAlgorithm.Solve();
         }
         catch (GRBException& e)
@@ -110,6 +112,7 @@ int main(int argc, char** argv)
     std::string parameterFile;
     bool enableTimeSuffix = true;
     int seedOffset = 0;
+    std::string loadingCacheFile;
 
     app.add_option("-i,--inputdir", inputFilePath, "The directory where the input file -f resides")->required();
     app.add_option("-f,--file", filename, "The input file name")->required();
@@ -119,6 +122,9 @@ int main(int argc, char** argv)
                    enableTimeSuffix,
                    "If the current time should be appended to the output path as a subfolder (1=true, 0=false)");
     app.add_option("-s,--seedOffset", seedOffset, "The offset to the internal seed");
+    app.add_option("-c,--loadingCache",
+                   loadingCacheFile,
+                   "The full file path of a persistent loading cache that is read at start and extended at the end");
 
     CLI11_PARSE(app, argc, argv);
 
@@ -142,7 +148,7 @@ int main(int argc, char** argv)
     }
     try
     {
-        Run(inputFilePath, filename, parameterFile, outdir, enableTimeSuffix, seedOffset);
+        Run(inputFilePath, filename, parameterFile, outdir, enableTimeSuffix, seedOffset, loadingCacheFile);
         return EXIT_SUCCESS;
     }
     catch (std::exception& e)
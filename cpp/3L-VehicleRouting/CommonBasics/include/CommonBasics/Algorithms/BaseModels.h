@@ -4,11 +4,13 @@
 #include "CommonBasics/Helper/ModelServices.h"
 
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 namespace BaseModels
 {
+/// Columns and costs are referenced and must outlive the model.
 template <typename TContainer> class SetProblems
 {
   public:
@@ -16,9 +18,9 @@ template <typename TContainer> class SetProblems
                 bool relaxation,
                 const TContainer& columns,
                 Collections::IdVector rows,
-                std::vector<double> costs,
+                const std::vector<double>& costs,
                 size_t maxCols)
-    : mRelaxation(relaxation), mColumns(columns), mRows(std::move(rows)), mCosts(std::move(costs)), mMaxColumns(maxCols)
+    : mRelaxation(relaxation), mColumns(columns), mRows(std::move(rows)), mCosts(costs), mMaxColumns(maxCols)
     {
         mModel = std::make_unique<GRBModel>(*env);
     };
@@ -60,9 +62,9 @@ template <typename TContainer> class SetProblems
 
   protected:
     size_t mMaxColumns;
-    TContainer mColumns;
+    const TContainer& mColumns;
     Collections::IdVector mRows;
-    std::vector<double> mCosts;
+    const std::vector<double>& mCosts;
     std::unique_ptr<GRBModel> mModel = nullptr;
     GRBVar1D mXVariables;
     bool mRelaxation;
@@ -85,6 +87,33 @@ template <typename TContainer> class SetProblems
         }
     };
 
+    /// Sum of variables of all columns that contain the row, for each row. Single pass over all columns.
+    [[nodiscard]] std::vector<GRBLinExpr> BuildRowExpressions() const
+    {
+        std::unordered_map<size_t, size_t> rowIndices;
+        for (size_t iRow = 0; iRow < mRows.size(); ++iRow)
+        {
+            rowIndices.emplace(mRows[iRow], iRow);
+        }
+
+        std::vector<GRBLinExpr> rowExpressions(mRows.size(), 0);
+        int iCol = 0;
+        for (const auto& column: mColumns)
+        {
+            for (const auto& element: column)
+            {
+                if (auto it = rowIndices.find(element); it != rowIndices.end())
+                {
+                    rowExpressions[it->second] += mXVariables[iCol];
+                }
+            }
+
+            iCol++;
+        }
+
+        return rowExpressions;
+    }
+
     virtual bool AddConstraints() = 0;
 };
 
@@ -95,27 +124,15 @@ template <typename TContainer> class SetPartitioning : public SetProblems<TConta
                     bool relaxation,
                     const TContainer& columns,
                     Collections::IdVector rows,
-                    std::vector<double> costs,
+                    const std::vector<double>& costs,
                     size_t maxCols)
     : SetProblems<TContainer>(env, relaxation, columns, rows, costs, maxCols){};
 
   private:
     [[nodiscard]] bool AddConstraints()
     {
-        for (const auto& row: this->mRows)
+        for (const auto& sumSets: this->BuildRowExpressions())
         {
-            GRBLinExpr sumSets = 0;
-            int iCol = 0;
-            for (const auto& column: this->mColumns)
-            {
-                if (std::find(std::begin(column), std::end(column), row) != std::end(column))
-                {
-                    sumSets += this->mXVariables[iCol];
-                }
-
-                iCol++;
-            }
-
             if (sumSets.size() == 0)
             {
                 return false;
@@ -145,27 +162,15 @@ template <typename TContainer> class SetCovering : public SetProblems<TContainer
                 bool relaxation,
                 const TContainer& columns,
                 Collections::IdVector rows,
-                std::vector<double> costs,
+                const std::vector<double>& costs,
                 size_t maxCols)
     : SetProblems<TContainer>(env, relaxation, columns, rows, costs, maxCols){};
 
   private:
     [[nodiscard]] bool AddConstraints()
     {
-        for (const auto& row: this->mRows)
+        for (const auto& sumSets: this->BuildRowExpressions())
         {
-            GRBLinExpr sumSets = 0;
-            int iCol = 0;
-            for (const auto& column: this->mColumns)
-            {
-                if (std::find(std::begin(column), std::end(column), row) != std::end(column))
-                {
-                    sumSets += this->mXVariables[iCol];
-                }
-
-                iCol++;
-            }
-
             if (sumSets.size() == 0)
             {
                 return false;
@@ -13,6 +13,19 @@ struct CPSolverParams
 
     bool EnableCumulativeDimensions = false;
     bool EnableNoOverlap2DFloor = false;
+    /// Placement patterns of the axes are generated concurrently for at least this many items, 0 disables it.
+    int ParallelPatternItems = 20;
+
+    /// The following options are not yet validated against the baseline -> disabled by default, all enabled in
+    /// BenchmarkParameters_AllConstraintsCPExtensions.json.
+
+    /// Identical items (HomogeneityHash) are placed in lexicographic order of their start positions.
+    bool EnableSymmetryBreaking = false;
+    /// Number of CP models kept to check the same route with other loading masks, 0 disables the reuse.
+    int ReusableModels = 0;
+    /// Each axis is divided by the GCD of the container and item dimensions along it, if the placement patterns of
+    /// all masks consist of multiples of it (not for unit discretization).
+    bool EnableDimensionScaling = false;
 };
 
 }
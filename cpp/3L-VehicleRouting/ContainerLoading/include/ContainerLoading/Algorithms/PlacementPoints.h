@@ -81,6 +81,7 @@ class PlacementPointGenerator
 
     /// Regular normal patterns according to Côté, J. F., & Iori, M. (2018). The meet-in-the-middle principle for
     /// cutting and packing problems. INFORMS Journal on Computing, 30(4), 646-661.
+    /// Computed as word-parallel subset sums of the item lengths.
     static boost::dynamic_bitset<>
         DetermineRegularNormalPatternsX(int containerDx, int actualContainerDx, const std::vector<Cuboid*>& items);
 
@@ -113,13 +114,14 @@ class PlacementPointGenerator
                                                      const std::vector<Cuboid*>& items,
                                                      const Cuboid& itemI);
 
-    static boost::dynamic_bitset<> DetermineRegularNormalPatterns(const Container& container,
-                                                                  const std::vector<Cuboid*>& items,
-                                                                  const Cuboid& itemI,
-                                                                  std::vector<int>& meetInTheMiddlePointsLeftX,
-                                                                  std::vector<int>& meetInTheMiddlePointsRightX,
-                                                                  MeetInTheMiddleMinimizationTarget minimizationTarget,
-                                                                  Axis axis);
+    /// Count the left and right placement points of the regular normal patterns of itemI.
+    static void CountRegularNormalPatterns(const Container& container,
+                                           const boost::dynamic_bitset<>& regularNormalPatterns,
+                                           const Cuboid& itemI,
+                                           std::vector<int>& meetInTheMiddlePointsLeftX,
+                                           std::vector<int>& meetInTheMiddlePointsRightX,
+                                           MeetInTheMiddleMinimizationTarget minimizationTarget,
+                                           Axis axis);
 
     static boost::dynamic_bitset<> DetermineMeetInTheMiddlePatterns(const Container& container,
                                                                     const std::vector<Cuboid*>& items,
@@ -136,18 +138,20 @@ class PlacementPointGenerator
                                                                                         bool enablePreprocessingStep1,
                                                                                         bool enablePreprocessingStep2);
 
+    /// Item sums are the regular normal patterns of the filtered items in [0, containerDimension].
     static void DetermineSingleItemReducedLeftRightPatterns(int threshold,
                                                             int separationThreshold,
                                                             boost::dynamic_bitset<>& placementPointsLeft,
-                                                            const Container& container,
-                                                            Axis axis,
+                                                            int containerDimension,
                                                             int minSelectedItemDimension,
-                                                            const std::vector<Cuboid*>& doublyFilteredItems,
+                                                            const boost::dynamic_bitset<>& doublyFilteredItemSums,
                                                             boost::dynamic_bitset<>& placementPointsRightPrime,
-                                                            const std::vector<Cuboid*>& filteredItems);
+                                                            const boost::dynamic_bitset<>& filteredItemSums);
 
+    /// representatives[k] is the first item identical to item k, whose result is copied.
     static void DetermineEnlargedItemDimensionsLeft(
         std::vector<Cuboid>& items,
+        const std::vector<size_t>& representatives,
         Axis axis,
         std::vector<std::vector<int>>& itemSpecificModifiedItemDimensions,
         const std::vector<boost::dynamic_bitset<>>& itemSpecificPlacementPointsLeft,
@@ -155,12 +159,15 @@ class PlacementPointGenerator
         const std::vector<boost::dynamic_bitset<>>& preliminaryItemSpecificMeetInTheMiddleSets);
     static void DetermineEnlargedItemDimensionsRight(
         std::vector<Cuboid>& items,
+        const std::vector<size_t>& representatives,
         Axis axis,
         std::vector<std::vector<int>>& itemSpecificModifiedItemDimensions,
         std::vector<boost::dynamic_bitset<>>& itemSpecificPlacementPointsRightPrime,
         const std::vector<boost::dynamic_bitset<>>& preliminaryItemSpecificMeetInTheMiddleSets);
 
+    /// The result of representatives[k] is copied if item k has the same patterns and modified dimensions.
     static void RemoveRedundantPatterns(std::vector<Cuboid>& items,
+                                        const std::vector<size_t>& representatives,
                                         const std::vector<std::vector<int>>& itemSpecificModifiedItemDimensions,
                                         std::vector<boost::dynamic_bitset<>>& itemSpecificPlacementPointsLeft);
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Model/Container.h"
+
+#include "Algorithms/LoadingStatus.h"
+
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Model;
+namespace Algorithms
+{
+/// Necessary conditions for a feasible packing, in order of evaluation.
+enum class GeometricBound
+{
+    None = 0,
+    /// Each item fits into the container in an allowed orientation.
+    ItemDimensions,
+    /// Items larger than half of the container in two dimensions pairwise overlap in these dimensions and must be
+    /// placed one after another in the third dimension (L1 bound of Martello, Pisinger & Vigo).
+    LargeItems,
+    /// Volume bound with dual feasible functions of Fekete & Schepers applied to one dimension (L2-type bound).
+    DualFeasibleFunctions,
+    /// Items that cannot share a vertical column with any other item (height) or must be placed on the floor (support
+    /// with fragility) need disjoint floor area.
+    FloorArea,
+    /// Items whose cross-section exceeds half of the container cross-section along an axis cannot share a slice of
+    /// this axis (cumulative profile). Along the z-axis, this is the height profile of large footprints.
+    CumulativeProfile
+};
+
+/// Fast geometric tests that prove infeasibility of a single container loading problem without solving it.
+/// Horizontal rotation is considered by using the minimal dimension over all allowed orientations.
+class GeometricBounds
+{
+  public:
+    GeometricBounds(const Container& container,
+                    const std::vector<Cuboid>& items,
+                    const LoadingFlag loadingMask,
+                    const double supportArea)
+    : mContainer(container),
+      mItems(items),
+      mEnableFragility(IsSet(loadingMask, LoadingFlag::Fragility)),
+      mEnableSupport(IsSet(loadingMask, LoadingFlag::Support) && supportArea > 0.0)
+    {
+    }
+
+    /// Returns the first violated bound or None if all tests pass.
+    [[nodiscard]] GeometricBound FindViolatedBound() const;
+
+  private:
+    const Container& mContainer;
+    const std::vector<Cuboid>& mItems;
+
+    const bool mEnableFragility;
+    /// Items not on the floor must be supported by items directly below.
+    const bool mEnableSupport;
+
+    [[nodiscard]] bool ItemDimensionsViolated() const;
+    [[nodiscard]] bool LargeItemsViolated() const;
+    [[nodiscard]] bool DualFeasibleFunctionsViolated() const;
+    [[nodiscard]] bool FloorAreaViolated() const;
+    [[nodiscard]] bool CumulativeProfileViolated() const;
+
+    /// Lower bound of the volume fraction of all items after applying a dual feasible function with threshold
+    /// epsilon (relative) along axis.
+    [[nodiscard]] double DualFeasibleVolume(Axis axis, double epsilon) const;
+
+    /// Minimal cross-section area perpendicular to axis over all allowed orientations.
+    [[nodiscard]] static double MinimumCrossSection(const Cuboid& item, Axis axis);
+};
+
+}
+}
@@ -8,11 +8,33 @@
 #include "Algorithms/LoadingStatus.h"
 #include "Algorithms/PlacementPoints.h"
 
+#include "Helper/PlacementPatternCache.h"
+#include "Helper/StopToken.h"
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <tuple>
+#include <vector>
+
 namespace ContainerLoading
 {
 using namespace Model;
 namespace Algorithms
 {
+/// Position and rotation of an item in a related packing.
+struct PlacementHint
+{
+    int X = 0;
+    int Y = 0;
+    int Z = 0;
+    bool Rotated = false;
+};
+
+/// CP model of the single container loading problem for one or several loading masks. Constraint groups that are only
+/// enforced in some of the masks are guarded by enforcement literals, each mask is then solved with assumptions on these
+/// literals. The model and the placement patterns are built once in the first solve and reused for all masks.
 class ContainerLoadingCP
 {
   public:
@@ -22,8 +44,32 @@ class ContainerLoadingCP
     void PrintSolution();
     void ExtractPacking(std::vector<Cuboid>& items) const;
     [[nodiscard]] std::vector<int> ExtractSequence() const;
+    /// Group ids of customers whose items are sufficient for infeasibility (infeasible core). Only valid if customer
+    /// assumptions are enabled and the last solve returned Infeasible. The core is not necessarily minimal.
+    [[nodiscard]] std::vector<size_t> ExtractInfeasibleCustomers() const;
+
+    /// Guard the items of each customer by an assumption literal. Must be called before the first solve.
+    void EnableCustomerAssumptions() { mEnableCustomerAssumptions = true; }
+
+    /// Partial solution hint, indexed as items. Items without value are not hinted. Must be set before the first solve.
+    void SetSolutionHint(std::vector<std::optional<PlacementHint>> hint) { mSolutionHint = std::move(hint); }
+
+    /// Placement patterns are looked up in and added to the cache, which must outlive the first solve. Must be set
+    /// before the first solve.
+    void SetPlacementPatternCache(PlacementPatternCache* cache) { mPlacementPatternCache = cache; }
 
+    /// All solves end at the deadline of the token or as soon as a stop is requested. The token must outlive all
+    /// solves, may be nullptr.
+    void SetStopToken(const StopToken* stopToken) { mStopToken = stopToken; }
+
+    /// Solve the single mask of the model with the runtime given in the constructor.
     [[nodiscard]] LoadingStatus Solve();
+    /// loadingMask must be one of the masks of the model.
+    [[nodiscard]] LoadingStatus Solve(LoadingFlag loadingMask, double maxRuntime);
+    /// Solve with the given number of workers. The search is stopped (Unknown if not decided yet) as soon as stopFlag
+    /// is set by another thread, stopFlag may be nullptr.
+    [[nodiscard]] LoadingStatus
+        Solve(LoadingFlag loadingMask, double maxRuntime, int threads, std::atomic<bool>* stopFlag);
     [[nodiscard]] double GetRuntime() const { return mResponse.wall_time(); };
 
     ContainerLoadingCP(const CPSolverParams& params,
@@ -33,47 +79,100 @@ class ContainerLoadingCP
                        const LoadingFlag loadingMask,
                        const double supportArea,
                        const double maxRuntime)
+    : ContainerLoadingCP(params, container, items, numberCustomers, std::vector{loadingMask}, supportArea)
+    {
+        mMaxRuntime = maxRuntime;
+    }
+
+    ContainerLoadingCP(const CPSolverParams& params,
+                       const Container& container,
+                       const std::vector<Cuboid>& items,
+                       const size_t numberCustomers,
+                       const std::vector<LoadingFlag>& loadingMasks,
+                       const double supportArea)
     : mParams(params),
-      mContainer(container),
-      mItems(items),
+      mScales(DetermineScales(params, container, items, loadingMasks)),
+      mContainer(ScaleContainer(container, mScales)),
+      mItems(ScaleItems(items, mScales)),
       mNumberCustomers(numberCustomers),
-      mEnableFragility(IsSet(loadingMask, LoadingFlag::Fragility)),
-      mEnableLifo(IsSet(loadingMask, LoadingFlag::Lifo)),
-      mFixedSequence(IsSet(loadingMask, LoadingFlag::Sequence)),
-      mEnableSupport(IsSet(loadingMask, LoadingFlag::Support)),
-      mSupportArea(supportArea),
-      mMaxRuntime(maxRuntime)
+      mLoadingMasks(loadingMasks),
+      mEnableFragility(IsSetInAnyMask(loadingMasks, LoadingFlag::Fragility)),
+      mEnableLifoSequence(IsLifoInAnyMask(loadingMasks, true)),
+      mEnableLifoNoSequence(IsLifoInAnyMask(loadingMasks, false)),
+      mEnableSupport(IsSetInAnyMask(loadingMasks, LoadingFlag::Support)),
+      mSupportArea(supportArea)
     {
-        auto [placementPatternTypeX, placementPatternTypeY, placementPatternTypeZ] =
-            PlacementPointGenerator::SelectMinimalFeasiblePatternType(loadingMask);
-        mPlacementPatternTypeX = placementPatternTypeX;
-        mPlacementPatternTypeY = placementPatternTypeY;
-        mPlacementPatternTypeZ = placementPatternTypeZ;
     }
 
+    [[nodiscard]] const std::vector<LoadingFlag>& GetLoadingMasks() const { return mLoadingMasks; }
+
   private:
+    /// Enforcement literal of a constraint group. Only guarded groups are decided by assumptions, the literal of
+    /// unguarded groups is constant in all masks of the model.
+    struct EnforcementLiteral
+    {
+        operations_research::sat::BoolVar Literal;
+        bool IsGuarded = false;
+    };
+
     const CPSolverParams& mParams;
-    const Container& mContainer;
-    const std::vector<Cuboid>& mItems;
+    /// Unit of x, y and z (DimensionType) in the model. Container and items are scaled copies, positions are converted
+    /// back in ExtractPacking.
+    const std::array<int, 3> mScales;
+    /// Copies -> the model can be kept and solved again after the caller's data is gone.
+    const Container mContainer;
+    const std::vector<Cuboid> mItems;
     size_t mNumberCustomers;
 
+    const std::vector<LoadingFlag> mLoadingMasks;
+
+    /// Constraint groups that are enforced in at least one mask of the model.
     const bool mEnableFragility;
-    const bool mEnableLifo;
-    const bool mFixedSequence;
+    const bool mEnableLifoSequence;
+    const bool mEnableLifoNoSequence;
     const bool mEnableSupport;
 
     const double mSupportArea;
 
     const int mMaxReachability = 30;
 
-    const double mMaxRuntime;
+    double mMaxRuntime = std::numeric_limits<double>::max();
+
+    EnforcementLiteral mFragilityLiteral;
+    EnforcementLiteral mSupportLiteral;
+    EnforcementLiteral mLifoSequenceLiteral;
+    EnforcementLiteral mLifoNoSequenceLiteral;
+
+    /// Placement pattern types (x, y, z) used by the masks and the literal that restricts the start positions to the
+    /// patterns of this type. mMaskPatternTypes[m] is the index of the pattern types of mLoadingMasks[m].
+    std::vector<std::tuple<PlacementPattern, PlacementPattern, PlacementPattern>> mPatternTypes;
+    std::vector<EnforcementLiteral> mPatternLiterals;
+    std::vector<size_t> mMaskPatternTypes;
+
+    /// Classes of at least two identical items (HomogeneityHash), indices in ascending order.
+    std::vector<std::vector<size_t>> mIdenticalItems;
+
+    /// Smallest length, width and height of each item over its orientations (DimensionType). Pairs of items whose
+    /// smallest extents exceed the container cannot be separated along this dimension, their relative directions,
+    /// support and xy-intersection variables are constant.
+    std::vector<std::array<int, 3>> mMinimumDimensions;
 
-    PlacementPattern mPlacementPatternTypeX = PlacementPattern::None;
-    PlacementPattern mPlacementPatternTypeY = PlacementPattern::None;
-    PlacementPattern mPlacementPatternTypeZ = PlacementPattern::None;
+    /// mCustomerLiterals[g] is true if the items with group id g are packed, only created with customer assumptions.
+    bool mEnableCustomerAssumptions = false;
+    ORBoolVars1D mCustomerLiterals;
+
+    bool mIsBuilt = false;
+    operations_research::sat::CpModelProto mProtoModel;
 
     operations_research::sat::CpSolverResponse mResponse;
 
+    std::vector<std::optional<PlacementHint>> mSolutionHint;
+
+    /// Patterns are generated directly if no cache is set.
+    PlacementPatternCache* mPlacementPatternCache = nullptr;
+
+    const StopToken* mStopToken = nullptr;
+
     std::vector<Dimension> mDimensions = {{AxisY, Right, Left}, {AxisX, InFront, Behind}, {AxisZ, Above, Below}};
     std::vector<Orientation> mItemOrientations = std::vector{NoRotation, RotationZ};
 
@@ -112,7 +211,28 @@ class ContainerLoadingCP
 
     operations_research::sat::IntVar mMaxLength;
 
+    [[nodiscard]] static std::array<int, 3> DetermineScales(const CPSolverParams& params,
+                                                           const Container& container,
+                                                           const std::vector<Cuboid>& items,
+                                                           const std::vector<LoadingFlag>& loadingMasks);
+    [[nodiscard]] static Container ScaleContainer(const Container& container, const std::array<int, 3>& scales);
+    [[nodiscard]] static std::vector<Cuboid> ScaleItems(const std::vector<Cuboid>& items,
+                                                        const std::array<int, 3>& scales);
+
     void BuildModel();
+    void CreateEnforcementLiterals();
+    [[nodiscard]] EnforcementLiteral CreateEnforcementLiteral(size_t numberEnforcingMasks);
+    [[nodiscard]] std::vector<int> DetermineAssumptions(size_t maskIndex) const;
+    /// Customer literals of items i and j, empty without customer assumptions.
+    [[nodiscard]] ORBoolVars1D CustomerLiterals(size_t i, size_t j) const;
+    void CreateStartPositions(const std::vector<Cuboid>& items);
+    void DetermineIdenticalItems();
+    void DetermineMinimumDimensions();
+    [[nodiscard]] bool CanBeSeparated(size_t i, size_t j, DimensionType dimension) const;
+    /// Item j can support item i.
+    [[nodiscard]] bool CanSupport(size_t i, size_t j) const;
+    /// The items fit on top of each other, fragility may still forbid the contact.
+    [[nodiscard]] bool CanBeStacked(size_t i, size_t j) const;
     void AddConstraints();
     void CreateNoOverlap();
     void CreateItemOrientations();
@@ -125,11 +245,20 @@ class ContainerLoadingCP
     void CreateLifoNoSequence();
     void CreatePositioningConstraints();
     void CreateOnFloorConstraints();
+    void CreateSymmetryBreaking();
+    void AddLexicographicOrder(size_t i, size_t j);
+    void SortSolutionHintOfIdenticalItems();
+
+    void AddSolutionHint();
 
     void AddObjective();
     void CreateVariables();
 
-    void SetParameters(operations_research::sat::SatParameters& parameters) const;
+    void SetParameters(operations_research::sat::SatParameters& parameters, double maxRuntime, int threads) const;
+
+    [[nodiscard]] static bool IsSetInAnyMask(const std::vector<LoadingFlag>& masks, LoadingFlag flag);
+    /// LIFO with or without given sequence.
+    [[nodiscard]] static bool IsLifoInAnyMask(const std::vector<LoadingFlag>& masks, bool fixedSequence);
 };
 
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Model/Container.h"
+
+#include "Algorithms/LoadingStatus.h"
+
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Model;
+namespace Algorithms
+{
+/// Constructive extreme point heuristic for the single container loading problem with the same constraints as
+/// ContainerLoadingCP: horizontal rotation, fragility, support area and LIFO (loading mask).
+/// Items are placed one by one at the extreme point that is deepest in the container (min x), then lowest (min z),
+/// then leftmost (min y). Several item orders are tried, the first complete packing is kept.
+/// Without a fixed sequence, LIFO is checked for the order of the group ids, which is one valid sequence.
+/// Infeasible only means that the heuristic did not find a packing.
+class ContainerLoadingEP
+{
+  public:
+    ContainerLoadingEP(const Container& container,
+                       const std::vector<Cuboid>& items,
+                       const LoadingFlag loadingMask,
+                       const double supportArea)
+    : mContainer(container),
+      mItems(items),
+      mEnableFragility(IsSet(loadingMask, LoadingFlag::Fragility)),
+      mEnableLifo(IsSet(loadingMask, LoadingFlag::Lifo)),
+      mEnableSupport(IsSet(loadingMask, LoadingFlag::Support)),
+      mSupportArea(supportArea)
+    {
+    }
+
+    [[nodiscard]] LoadingStatus Solve();
+
+    /// Only valid if Solve() returned FeasOpt.
+    void ExtractPacking(std::vector<Cuboid>& items) const;
+
+  private:
+    struct Placement
+    {
+        int X = 0;
+        int Y = 0;
+        int Z = 0;
+        int Dx = 0;
+        int Dy = 0;
+        int Dz = 0;
+        bool Rotated = false;
+    };
+
+    struct ExtremePoint
+    {
+        int X = 0;
+        int Y = 0;
+        int Z = 0;
+
+        auto operator<=>(const ExtremePoint&) const = default;
+    };
+
+    const Container& mContainer;
+    const std::vector<Cuboid>& mItems;
+
+    const bool mEnableFragility;
+    const bool mEnableLifo;
+    const bool mEnableSupport;
+
+    const double mSupportArea;
+
+    /// Placements of the last packing attempt, indexed as mItems.
+    std::vector<Placement> mPlacements;
+    /// Indices of items placed in the last packing attempt.
+    std::vector<size_t> mPlacedItems;
+    std::vector<ExtremePoint> mExtremePoints;
+
+    [[nodiscard]] std::vector<std::vector<size_t>> DetermineItemOrders() const;
+
+    [[nodiscard]] bool Pack(const std::vector<size_t>& order);
+
+    [[nodiscard]] bool IsFeasible(size_t item, const Placement& placement) const;
+
+    [[nodiscard]] bool SatisfiesLifo(size_t item, const Placement& placement, size_t other) const;
+
+    void AddExtremePoints(const Placement& placement);
+
+    /// Moves point in negative direction of axis until it hits an item or the container wall.
+    [[nodiscard]] ExtremePoint Project(ExtremePoint point, Axis axis) const;
+};
+
+}
+}
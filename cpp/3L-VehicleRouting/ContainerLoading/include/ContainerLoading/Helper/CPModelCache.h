@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Algorithms/SingleContainer/OPP_CP_3D.h"
+#include "CommonBasics/Helper/ModelServices.h"
+#include "Model/Container.h"
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Algorithms;
+using namespace Model;
+
+/// CP model of a route that is kept to be solved again with another loading mask or a larger time limit.
+/// Solving a model modifies its response -> Mutex must be held while using Model.
+struct CachedCPModel
+{
+    Collections::IdVector Route;
+    int ContainerDx = 0;
+    int ContainerDy = 0;
+    int ContainerDz = 0;
+    /// Group id and dimensions of the items, the model is only reused for the same items.
+    std::vector<Cuboid> Items;
+
+    std::unique_ptr<ContainerLoadingCP> Model;
+    std::mutex Mutex;
+};
+
+/// Least recently used CP models, at most Capacity many. Evicted models stay valid while they are in use.
+/// Thread-safe.
+class CPModelCache
+{
+  public:
+    void SetCapacity(size_t capacity);
+    [[nodiscard]] size_t Capacity() const;
+
+    /// Returns the model of the route with container and items, creates it with createModel if it is not cached.
+    [[nodiscard]] std::shared_ptr<CachedCPModel>
+        FindOrCreate(const Collections::IdVector& route,
+                     const Container& container,
+                     const std::vector<Cuboid>& items,
+                     const std::function<std::unique_ptr<ContainerLoadingCP>()>& createModel);
+
+    [[nodiscard]] size_t Size() const;
+    [[nodiscard]] size_t Evictions() const;
+
+  private:
+    mutable std::mutex mMutex;
+    size_t mCapacity = 0;
+    /// Most recently used model first.
+    std::list<std::shared_ptr<CachedCPModel>> mModels;
+    size_t mEvictions = 0;
+
+    [[nodiscard]] static bool
+        Matches(const CachedCPModel& model, const Container& container, const std::vector<Cuboid>& items);
+};
+
+}
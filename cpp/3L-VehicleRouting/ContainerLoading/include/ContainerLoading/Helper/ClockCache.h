@@ -0,0 +1,222 @@
+#pragma once
+
+#include "CommonBasics/Helper/ModelServices.h"
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ContainerLoading
+{
+/// Size of one cache class, summed over all masks.
+struct LoadingCacheStatistics
+{
+    std::string Name;
+    size_t Entries = 0;
+    /// Approximate memory in bytes.
+    size_t MemoryUsage = 0;
+    size_t Evictions = 0;
+};
+
+[[nodiscard]] inline size_t HeapSize(const Collections::IdVector& sequence)
+{
+    return sequence.capacity() * sizeof(Collections::IdVector::value_type);
+}
+
+[[nodiscard]] inline size_t HeapSize(const boost::dynamic_bitset<>& set)
+{
+    return set.num_blocks() * sizeof(boost::dynamic_bitset<>::block_type);
+}
+
+/// Memory-bounded set of keys for results that are cheap to recompute. If the approximate memory usage exceeds the
+/// budget, keys are evicted with the CLOCK policy (second chance): the hand sweeps over all entries, clears the
+/// reference bit of recently used entries and evicts the first entry without reference bit.
+/// A budget of 0 disables eviction. Each key can carry a value. Thread-safe.
+template <typename Key, typename Hash, typename Value = bool> class ClockCache
+{
+  public:
+    void SetMemoryBudget(size_t bytes)
+    {
+        std::lock_guard lock(mMutex);
+        mMemoryBudget = bytes;
+        Evict();
+    }
+
+    /// Returns false if the key is already contained.
+    bool Insert(const Key& key, const Value& value = Value())
+    {
+        std::lock_guard lock(mMutex);
+        if (auto it = mPositions.find(key); it != mPositions.end())
+        {
+            mEntries[it->second].Referenced = true;
+            return false;
+        }
+
+        InsertNew(key, value);
+
+        return true;
+    }
+
+    /// Insert the key with value update(Value()) or replace the value of the stored key by update(value).
+    template <typename TUpdate> void Update(const Key& key, TUpdate&& update)
+    {
+        std::lock_guard lock(mMutex);
+        if (auto it = mPositions.find(key); it != mPositions.end())
+        {
+            auto& entry = mEntries[it->second];
+            entry.Data = update(entry.Data);
+            entry.Referenced = true;
+            return;
+        }
+
+        InsertNew(key, update(Value()));
+    }
+
+    /// Returns the value and marks the key as recently used if it is contained.
+    [[nodiscard]] std::optional<Value> Find(const Key& key) const
+    {
+        std::lock_guard lock(mMutex);
+        auto it = mPositions.find(key);
+        if (it == mPositions.end())
+        {
+            return std::nullopt;
+        }
+
+        const auto& entry = mEntries[it->second];
+        entry.Referenced = true;
+        return entry.Data;
+    }
+
+    /// Marks the key as recently used if it is contained.
+    [[nodiscard]] bool Contains(const Key& key) const
+    {
+        std::lock_guard lock(mMutex);
+        auto it = mPositions.find(key);
+        if (it == mPositions.end())
+        {
+            return false;
+        }
+
+        mEntries[it->second].Referenced = true;
+        return true;
+    }
+
+    [[nodiscard]] size_t Size() const
+    {
+        std::lock_guard lock(mMutex);
+        return mPositions.size();
+    }
+
+    /// Approximate memory in bytes.
+    [[nodiscard]] size_t MemoryUsage() const
+    {
+        std::lock_guard lock(mMutex);
+        return mMemoryUsage;
+    }
+
+    [[nodiscard]] size_t Evictions() const
+    {
+        std::lock_guard lock(mMutex);
+        return mEvictions;
+    }
+
+  private:
+    struct Entry
+    {
+        Key Id;
+        Value Data;
+        bool Occupied = false;
+        mutable bool Referenced = false;
+    };
+
+    mutable std::mutex mMutex;
+
+    std::vector<Entry> mEntries;
+    std::unordered_map<Key, size_t, Hash> mPositions;
+    std::vector<size_t> mFreePositions;
+
+    size_t mHand = 0;
+    size_t mMemoryBudget = 0;
+    size_t mMemoryUsage = 0;
+    size_t mEvictions = 0;
+
+    [[nodiscard]] static size_t EntrySize(const Key& key)
+    {
+        // Entry, copy of the key in the hash map, map node and bucket pointers, and heap memory of both keys.
+        return sizeof(Entry) + sizeof(Key) + sizeof(size_t) + 2 * sizeof(void*) + 2 * HeapSize(key);
+    }
+
+    void InsertNew(const Key& key, const Value& value)
+    {
+        size_t position = mEntries.size();
+        if (!mFreePositions.empty())
+        {
+            position = mFreePositions.back();
+            mFreePositions.pop_back();
+            mEntries[position] = Entry{key, value, true, true};
+        }
+        else
+        {
+            mEntries.push_back(Entry{key, value, true, true});
+        }
+
+        mPositions.emplace(key, position);
+        mMemoryUsage += EntrySize(mEntries[position].Id);
+
+        Evict();
+    }
+
+    void Evict()
+    {
+        if (mMemoryBudget == 0)
+        {
+            return;
+        }
+
+        while (mMemoryUsage > mMemoryBudget && !mPositions.empty())
+        {
+            auto& entry = mEntries[mHand];
+            mHand = (mHand + 1) % mEntries.size();
+
+            if (!entry.Occupied)
+            {
+                continue;
+            }
+
+            if (entry.Referenced)
+            {
+                entry.Referenced = false;
+                continue;
+            }
+
+            mMemoryUsage -= EntrySize(entry.Id);
+            mPositions.erase(entry.Id);
+            mFreePositions.push_back(&entry - mEntries.data());
+            entry = Entry();
+            mEvictions++;
+        }
+    }
+};
+
+using SequenceClockCache = ClockCache<Collections::IdVector, Collections::container_hash<Collections::IdVector>>;
+using SetClockCache = ClockCache<boost::dynamic_bitset<>, std::hash<boost::dynamic_bitset<>>>;
+
+/// Time invested in a sequence or set whose CP calls all hit the time limit.
+struct UnknownLoadingResult
+{
+    /// Largest time limit in seconds of all calls.
+    double TimeBudget = 0.0;
+    /// Sum of time limits in seconds of all calls.
+    double TotalTime = 0.0;
+    size_t Calls = 0;
+};
+
+using UnknownSequenceCache =
+    ClockCache<Collections::IdVector, Collections::container_hash<Collections::IdVector>, UnknownLoadingResult>;
+using UnknownSetCache = ClockCache<boost::dynamic_bitset<>, std::hash<boost::dynamic_bitset<>>, UnknownLoadingResult>;
+
+}
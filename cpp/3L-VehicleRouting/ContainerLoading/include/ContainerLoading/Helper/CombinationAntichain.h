@@ -0,0 +1,63 @@
+#pragma once
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <shared_mutex>
+#include <vector>
+
+namespace ContainerLoading
+{
+struct CombinationAntichainStatistics
+{
+    size_t Queries = 0;
+    size_t Hits = 0;
+    /// Number of stored combinations that were compared against a query.
+    size_t ComparedCombinations = 0;
+
+    size_t Inserted = 0;
+    /// Insertions rejected because a subset was already stored (includes duplicates).
+    size_t RejectedDominated = 0;
+    /// Stored combinations removed because a new subset was inserted.
+    size_t RemovedSupersets = 0;
+};
+
+/// Inclusion-minimal customer combinations, i.e., no stored combination is a subset of another one.
+/// Each combination is indexed by all of its customers, so that queries only touch combinations sharing a customer with
+/// the queried route.
+/// Thread-safe: queries run concurrently under a shared lock, insertions are exclusive.
+class CombinationAntichain
+{
+  public:
+    /// Returns false if a subset of the combination (or the combination itself) is already stored.
+    bool Insert(const boost::dynamic_bitset<>& combination);
+
+    /// Is there a stored combination C with C \subseteq set?
+    [[nodiscard]] bool ContainsSubsetOf(const boost::dynamic_bitset<>& set) const;
+
+    [[nodiscard]] size_t Size() const;
+    [[nodiscard]] CombinationAntichainStatistics Statistics() const;
+
+  private:
+    mutable std::shared_mutex mMutex;
+
+    std::vector<boost::dynamic_bitset<>> mCombinations;
+    std::vector<size_t> mCardinalities;
+    std::vector<bool> mActive;
+
+    /// mCombinationsByFirstCustomer[c]: ids of (possibly removed) combinations whose smallest customer is c.
+    std::vector<std::vector<size_t>> mCombinationsByFirstCustomer;
+    /// mCombinationsByCustomer[c]: ids of (possibly removed) combinations that contain customer c.
+    std::vector<std::vector<size_t>> mCombinationsByCustomer;
+
+    size_t mSize = 0;
+    size_t mRemoved = 0;
+
+    /// Query counters are updated atomically under the shared lock.
+    mutable CombinationAntichainStatistics mStatistics;
+
+    [[nodiscard]] bool FindSubsetOf(const boost::dynamic_bitset<>& set, size_t& comparedCombinations) const;
+    void RemoveSupersetsOf(const boost::dynamic_bitset<>& combination, size_t cardinality);
+    void Compact();
+};
+
+}
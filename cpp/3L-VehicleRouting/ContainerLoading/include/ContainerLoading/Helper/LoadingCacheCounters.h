@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Algorithms/LoadingStatus.h"
+#include "Algorithms/SingleContainer/GeometricBounds.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Algorithms;
+
+enum class CacheLookup
+{
+    FeasibleSequence = 0,
+    InfeasibleSequence,
+    UnknownSequence,
+    /// Stored feasible supersequence or infeasible subsequence, only without support.
+    FeasibleSupersequence,
+    InfeasibleSubsequence,
+    FeasibleSet,
+    InfeasibleSet,
+    UnknownSet,
+    HeuristicInfeasibleSequence,
+    TwoOptCheckedSequence
+};
+
+struct CacheLookupStatistics
+{
+    LoadingFlag Mask = LoadingFlag::NoneSet;
+    CacheLookup Lookup = CacheLookup::FeasibleSequence;
+    size_t Hits = 0;
+    size_t Misses = 0;
+    /// Total time of all lookups in seconds.
+    double LookupTime = 0.0;
+    /// Hits times average CP solve time of the mask in seconds. 0 for heuristic caches.
+    double EstimatedSavedTime = 0.0;
+};
+
+struct CPSolveStatistics
+{
+    LoadingFlag Mask = LoadingFlag::NoneSet;
+    size_t Calls = 0;
+    /// Total solve time in seconds.
+    double Time = 0.0;
+};
+
+struct GeometricBoundStatistics
+{
+    /// None counts checks in which no bound was violated.
+    GeometricBound Bound = GeometricBound::None;
+    size_t Hits = 0;
+    /// Total time of the checks ending with this result in seconds.
+    double Time = 0.0;
+};
+
+/// Hit and miss counters of all cache lookups and CP solve times per mask. Thread-safe (relaxed atomics).
+class LoadingCacheCounters
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Count a lookup that started at start.
+    void AddLookup(LoadingFlag mask, CacheLookup lookup, bool hit, Clock::time_point start);
+    void AddSolve(LoadingFlag mask, Clock::time_point start);
+    /// Count a geometric bound check that started at start and ended with the violated bound.
+    void AddBoundCheck(GeometricBound bound, Clock::time_point start);
+
+    /// Statistics of all used (mask, lookup) combinations.
+    [[nodiscard]] std::vector<CacheLookupStatistics> Lookups() const;
+    [[nodiscard]] std::vector<CPSolveStatistics> Solves() const;
+    /// Statistics of all bounds including None.
+    [[nodiscard]] std::vector<GeometricBoundStatistics> Bounds() const;
+
+  private:
+    /// All combinations of the basic loading flags.
+    static constexpr size_t NumberMasks = 32;
+    static constexpr size_t NumberLookups = static_cast<size_t>(CacheLookup::TwoOptCheckedSequence) + 1;
+    static constexpr size_t NumberBounds = static_cast<size_t>(GeometricBound::CumulativeProfile) + 1;
+
+    struct Counter
+    {
+        std::atomic<size_t> Hits = 0;
+        std::atomic<size_t> Misses = 0;
+        std::atomic<uint64_t> Nanoseconds = 0;
+    };
+
+    std::array<std::array<Counter, NumberLookups>, NumberMasks> mLookups;
+    /// Hits of Counter are used as number of calls.
+    std::array<Counter, NumberMasks> mSolves;
+    /// Hits of Counter are used as number of checks.
+    std::array<Counter, NumberBounds> mBounds;
+
+    [[nodiscard]] static uint64_t ElapsedNanoseconds(Clock::time_point start);
+};
+
+}
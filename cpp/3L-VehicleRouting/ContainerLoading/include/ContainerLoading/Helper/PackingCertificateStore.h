@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Helper/RouteStore.h"
+#include "Model/Container.h"
+
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Model;
+
+/// Placement of one item in a certified packing.
+struct CertifiedPlacement
+{
+    int X = 0;
+    int Y = 0;
+    int Z = 0;
+    bool Rotated = false;
+    /// Position of the customer of the item in the route.
+    size_t Stop = 0;
+};
+
+/// Feasible packings of interned routes, stored as position and rotation per item in the order of the items of the
+/// route (see LoadingChecker::SelectItems). Items of one customer are consecutive and share their group id.
+/// Coordinates are stored as 16-bit values.
+/// Thread-safe: the first certificate of a route is kept, later ones are ignored.
+class PackingCertificateStore
+{
+  public:
+    /// Returns false if a certificate of the route is already stored or a coordinate exceeds the 16-bit range.
+    bool Insert(RouteHandle handle, const Collections::IdVector& route, const std::vector<Cuboid>& items);
+
+    /// Sets position and rotation of items. Returns false if no certificate with the same number of items is stored.
+    [[nodiscard]] bool Apply(RouteHandle handle, std::vector<Cuboid>& items) const;
+
+    /// Empty if no certificate of the route is stored.
+    [[nodiscard]] std::vector<CertifiedPlacement> Find(RouteHandle handle) const;
+
+    /// Route of the last certificate containing node or InvalidHandle.
+    [[nodiscard]] RouteHandle LastCertificateOfNode(size_t node) const;
+
+    [[nodiscard]] size_t Size() const;
+
+    /// Approximate heap memory in bytes.
+    [[nodiscard]] size_t MemoryUsage() const;
+
+  private:
+    struct Placement
+    {
+        uint16_t X = 0;
+        uint16_t Y = 0;
+        uint16_t Z = 0;
+        bool Rotated = false;
+        uint16_t Stop = 0;
+    };
+
+    struct Certificate
+    {
+        uint32_t Offset = 0;
+        uint32_t NumberItems = 0;
+    };
+
+    mutable std::shared_mutex mMutex;
+    std::vector<Placement> mPlacements;
+    std::unordered_map<RouteHandle, Certificate> mCertificates;
+    std::vector<RouteHandle> mLastCertificateByNode;
+};
+
+}
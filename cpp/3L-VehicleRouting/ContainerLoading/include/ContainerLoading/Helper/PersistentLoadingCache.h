@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CommonBasics/Helper/ModelServices.h"
+
+#include "Algorithms/LoadingStatus.h"
+#include "Model/Container.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Algorithms;
+using namespace Model;
+
+/// Result of a loading check that is kept across runs.
+struct PersistentLoadingEntry
+{
+    LoadingFlag Mask = LoadingFlag::NoneSet;
+    LoadingStatus Status = LoadingStatus::Invalid;
+    /// Size of the customer set of the check, the set consists of the nodes in Sequence. 0 if no set was given.
+    size_t SetSize = 0;
+    /// Time limit of the call that produced the entry. Only relevant for unknown results.
+    double TimeBudget = 0.0;
+    Collections::IdVector Sequence;
+};
+
+/// Append-only binary file of loading results. Each record carries a key that identifies instance content, container
+/// and problem parameters, so that one file can be shared between instances and parameter files. The file is
+/// memory-mapped read-only when loading and new records are appended when saving.
+/// Each record starts with a magic number and is protected by a CRC-32; reading stops at the first corrupt or truncated
+/// record (e.g. from an aborted run), which is cut off before the next append. Several processes may share one file:
+/// appending holds an exclusive and loading a sharable lock on the file <filePath>.lock. The lock synchronizes
+/// processes, not threads of one process.
+class PersistentLoadingCache
+{
+  public:
+    PersistentLoadingCache(std::string filePath, uint64_t key) : mFilePath(std::move(filePath)), mKey(key) {}
+
+    /// Read all records with matching key.
+    [[nodiscard]] std::vector<PersistentLoadingEntry> Load() const;
+
+    /// Append records with the key of this cache.
+    void Append(const std::vector<PersistentLoadingEntry>& entries) const;
+
+    [[nodiscard]] static uint64_t HashContainer(uint64_t seed, const Container& container);
+    [[nodiscard]] static uint64_t HashItems(uint64_t seed, const std::vector<Cuboid>& items);
+    [[nodiscard]] static uint64_t HashValue(uint64_t seed, double value);
+
+  private:
+    static constexpr uint64_t FileIdentifier = 0x3243524C43334C33; // "3L3CLRC2"
+
+    std::string mFilePath;
+    uint64_t mKey;
+};
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Algorithms/PlacementPoints.h"
+#include "Model/Container.h"
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <compare>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ContainerLoading
+{
+using namespace Algorithms;
+using namespace Model;
+
+/// Item properties that determine its placement patterns. Other properties (fragility, weight, group id) are not used
+/// by the pattern generators.
+struct ItemGeometry
+{
+    int Dx = 0;
+    int Dy = 0;
+    int Dz = 0;
+    bool EnableHorizontalRotation = false;
+
+    auto operator<=>(const ItemGeometry&) const = default;
+};
+
+/// Pattern type of one axis in a container for a multiset of item geometries, sorted ascending.
+struct PlacementPatternKey
+{
+    int ContainerDx = 0;
+    int ContainerDy = 0;
+    int ContainerDz = 0;
+    PlacementPattern PatternType = PlacementPattern::None;
+    Axis PatternAxis = Axis::X;
+    std::vector<ItemGeometry> Items;
+
+    bool operator==(const PlacementPatternKey&) const = default;
+};
+
+struct PlacementPatternKeyHash
+{
+    [[nodiscard]] size_t operator()(const PlacementPatternKey& key) const;
+};
+
+/// Placement patterns of item sets that recur in many routes (same customers in another sequence or in a superset).
+/// Patterns are stored for the sorted item geometries and mapped to the order of the requested items. If the
+/// approximate memory usage exceeds the budget, least recently used patterns are evicted, a budget of 0 disables
+/// eviction. Thread-safe.
+class PlacementPatternCache
+{
+  public:
+    void SetMemoryBudget(size_t bytes);
+
+    /// Same result as PlacementPointGenerator::GeneratePlacementPatterns, indexed as items. Patterns are generated
+    /// outside the lock if they are not cached.
+    [[nodiscard]] std::vector<boost::dynamic_bitset<>> GeneratePlacementPatterns(const Container& container,
+                                                                               const std::vector<Cuboid>& items,
+                                                                               PlacementPattern patternType,
+                                                                               Axis axis);
+
+    [[nodiscard]] size_t Size() const;
+    /// Approximate memory in bytes.
+    [[nodiscard]] size_t MemoryUsage() const;
+    [[nodiscard]] size_t Evictions() const;
+
+  private:
+    struct Entry
+    {
+        PlacementPatternKey Key;
+        /// Indexed as Key.Items.
+        std::vector<boost::dynamic_bitset<>> Patterns;
+        size_t MemoryUsage = 0;
+    };
+
+    mutable std::mutex mMutex;
+
+    /// Most recently used entry first.
+    std::list<Entry> mEntries;
+    std::unordered_map<PlacementPatternKey, std::list<Entry>::iterator, PlacementPatternKeyHash> mPositions;
+
+    size_t mMemoryBudget = 0;
+    size_t mMemoryUsage = 0;
+    size_t mEvictions = 0;
+
+    [[nodiscard]] static size_t EntrySize(const Entry& entry);
+    /// Requires mMutex.
+    void Evict();
+};
+
+}
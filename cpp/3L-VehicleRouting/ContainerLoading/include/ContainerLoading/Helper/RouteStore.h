@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CommonBasics/Helper/ModelServices.h"
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <shared_mutex>
+#include <vector>
+
+namespace ContainerLoading
+{
+using RouteHandle = uint32_t;
+
+/// Interns routes (sequences of node ids) and identifies them by a 32-bit handle.
+/// Node ids of all routes are stored consecutively as 16-bit values, each route is hashed once to a 64-bit fingerprint.
+/// Lookup uses an open-addressing table (linear probing) over the handles.
+/// Thread-safe: routes are distributed by fingerprint over shards with separate storage and reader-writer lock, so
+/// concurrent lookups never block each other and concurrent insertions only block if they hit the same shard.
+class RouteStore
+{
+  public:
+    static constexpr RouteHandle InvalidHandle = std::numeric_limits<RouteHandle>::max();
+
+    void Reserve(size_t numberRoutes, size_t averageLength = 8);
+
+    /// Returns the handle of route and stores the route if it is not stored yet.
+    RouteHandle Intern(const Collections::IdVector& route);
+
+    /// Returns the handle of route or InvalidHandle if the route is not stored.
+    [[nodiscard]] RouteHandle Find(const Collections::IdVector& route) const;
+
+    [[nodiscard]] Collections::IdVector Get(RouteHandle handle) const;
+
+    [[nodiscard]] size_t Size() const;
+
+    /// Approximate heap memory in bytes.
+    [[nodiscard]] size_t MemoryUsage() const;
+
+  private:
+    using NodeId = uint16_t;
+
+    static constexpr RouteHandle EmptySlot = InvalidHandle;
+    /// Handle h belongs to shard h % NumberShards, with local index h / NumberShards in this shard.
+    static constexpr size_t NumberShards = 16;
+
+    struct Shard
+    {
+        mutable std::shared_mutex Mutex;
+
+        std::vector<NodeId> Nodes;
+        /// Route with local index l consists of Nodes[Offsets[l]], ..., Nodes[Offsets[l + 1] - 1].
+        std::vector<uint32_t> Offsets = {0};
+        std::vector<uint64_t> Fingerprints;
+        /// Local indices of stored routes.
+        std::vector<uint32_t> Slots;
+
+        [[nodiscard]] size_t Size() const { return Fingerprints.size(); }
+
+        [[nodiscard]] bool Equals(uint32_t local, const Collections::IdVector& route) const;
+        [[nodiscard]] size_t FindSlot(uint64_t fingerprint, const Collections::IdVector& route) const;
+
+        void Rehash(size_t numberSlots);
+    };
+
+    std::array<Shard, NumberShards> mShards;
+
+    [[nodiscard]] static uint64_t Fingerprint(const Collections::IdVector& route);
+    /// Slots are selected by the low bits of the fingerprint, shards by the high bits.
+    [[nodiscard]] static size_t ShardIndex(uint64_t fingerprint) { return fingerprint >> 60; }
+};
+
+/// Set of interned routes, stored as membership bit per route handle. Thread-safe.
+class RouteSet
+{
+  public:
+    /// Returns false if the route is already contained.
+    bool Insert(RouteHandle handle);
+
+    [[nodiscard]] bool Contains(RouteHandle handle) const;
+
+    [[nodiscard]] size_t Size() const;
+
+    /// Approximate heap memory in bytes, routes are stored in the route store.
+    [[nodiscard]] size_t MemoryUsage() const;
+
+  private:
+    mutable std::shared_mutex mMutex;
+    boost::dynamic_bitset<> mMembers;
+    size_t mSize = 0;
+};
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CommonBasics/Helper/ModelServices.h"
+
+#include <shared_mutex>
+#include <vector>
+
+namespace ContainerLoading
+{
+/// Index over sequences of node ids that answers subsequence and supersequence queries (order-preserving, not
+/// necessarily contiguous) without scanning all stored sequences.
+/// - Subsequence query: each sequence is registered under its first node. A stored sequence T can only be a
+///   subsequence of S if T[0] is in S, so only the buckets of nodes in S are scanned.
+/// - Supersequence query: each sequence is registered under all of its nodes (inverted index). A stored sequence T
+///   can only be a supersequence of S if it contains every node of S, so only the shortest posting list of the nodes in
+///   S is scanned.
+/// Candidates are verified by a linear merge. Nodes must not occur twice in a sequence.
+/// Thread-safe: sequences are only appended, queries run concurrently under a shared lock.
+class SequenceContainmentIndex
+{
+  public:
+    /// Sequences must not be inserted twice, the caller keeps track of exact matches.
+    void Insert(const Collections::IdVector& sequence);
+
+    /// Is there a stored sequence T that is a subsequence of sequence?
+    [[nodiscard]] bool ContainsSubsequenceOf(const Collections::IdVector& sequence) const;
+
+    /// Is there a stored sequence T such that sequence is a subsequence of T?
+    [[nodiscard]] bool ContainsSupersequenceOf(const Collections::IdVector& sequence) const;
+
+    [[nodiscard]] size_t Size() const;
+
+    /// Approximate heap memory in bytes.
+    [[nodiscard]] size_t MemoryUsage() const;
+
+  private:
+    mutable std::shared_mutex mMutex;
+
+    /// Sequence with id i consists of mNodes[mOffsets[i]], ..., mNodes[mOffsets[i + 1] - 1].
+    std::vector<size_t> mNodes;
+    std::vector<size_t> mOffsets = {0};
+
+    /// mSequencesByFirstNode[v]: ids of stored sequences that start with v.
+    std::vector<std::vector<size_t>> mSequencesByFirstNode;
+    /// mSequencesByNode[v]: ids of stored sequences that contain v.
+    std::vector<std::vector<size_t>> mSequencesByNode;
+
+    /// The empty sequence is a subsequence of every sequence and has no node to be registered under.
+    bool mContainsEmptySequence = false;
+
+    [[nodiscard]] size_t Length(size_t id) const { return mOffsets[id + 1] - mOffsets[id]; }
+
+    /// Is the stored sequence with id a subsequence of sequence?
+    [[nodiscard]] bool IsSubsequence(size_t id, const Collections::IdVector& sequence) const;
+    /// Is sequence a subsequence of the stored sequence with id?
+    [[nodiscard]] bool IsSupersequence(size_t id, const Collections::IdVector& sequence) const;
+};
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace ContainerLoading
+{
+/// Index over customer sets that answers exact, subset and superset queries without scanning all stored sets.
+/// - Subset query: each set is registered under its smallest element. A stored set T can only be a subset of S if
+///   min(T) is in S, so only the buckets of elements in S are scanned.
+/// - Superset query: each set is registered under all of its elements (inverted index). A stored set T can only be a
+///   superset of S if it contains every element of S, so only the shortest posting list of the elements in S is
+///   scanned.
+/// Thread-safe: sets are only appended, queries run concurrently under a shared lock.
+class SetContainmentIndex
+{
+  public:
+    void Reserve(size_t size);
+
+    /// Returns false if the set is already stored.
+    bool Insert(const boost::dynamic_bitset<>& set);
+
+    [[nodiscard]] bool Contains(const boost::dynamic_bitset<>& set) const;
+
+    /// Is there a stored set T with T \subseteq set?
+    [[nodiscard]] bool ContainsSubsetOf(const boost::dynamic_bitset<>& set) const;
+
+    /// Is there a stored set T with set \subseteq T?
+    [[nodiscard]] bool ContainsSupersetOf(const boost::dynamic_bitset<>& set) const;
+
+    [[nodiscard]] size_t Size() const;
+    [[nodiscard]] bool Empty() const { return Size() == 0; }
+
+    /// Approximate heap memory in bytes.
+    [[nodiscard]] size_t MemoryUsage() const;
+
+  private:
+    mutable std::shared_mutex mMutex;
+
+    std::vector<boost::dynamic_bitset<>> mSets;
+    std::vector<size_t> mCardinalities;
+
+    std::unordered_set<boost::dynamic_bitset<>> mExactSets;
+
+    /// mSetsByMinElement[e]: ids of stored sets whose smallest element is e.
+    std::vector<std::vector<size_t>> mSetsByMinElement;
+    /// mSetsByElement[e]: ids of stored sets that contain e.
+    std::vector<std::vector<size_t>> mSetsByElement;
+
+    /// The empty set is a subset of every set and has no element to be registered under.
+    bool mContainsEmptySet = false;
+
+    void ResizeElementLists(size_t size);
+};
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace ContainerLoading
+{
+/// Deadline and stop request of a run, shared by all CP solves, heuristics and preprocessing loops. CP-SAT polls the
+/// stop flag itself, all other components poll StopRequested between their steps. Thread-safe, RequestStop is lock-free
+/// and may be called from a signal handler.
+class StopToken
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Deadline in timeLimit seconds from now. Without a deadline, only a stop request ends the run.
+    void SetTimeLimit(double timeLimit);
+
+    void RequestStop() { mStopRequested.store(true, std::memory_order_relaxed); }
+
+    /// Stop requested or deadline passed.
+    [[nodiscard]] bool StopRequested() const;
+    /// Seconds until the deadline, 0 if stopped.
+    [[nodiscard]] double RemainingTime() const;
+    /// maxRuntime of a solve cut at the deadline.
+    [[nodiscard]] double LimitRuntime(double maxRuntime) const;
+
+    /// Only set by RequestStop, the deadline is passed to solvers as time limit (see LimitRuntime).
+    [[nodiscard]] std::atomic<bool>* StopFlag() const { return &mStopRequested; }
+
+  private:
+    static_assert(std::atomic<bool>::is_always_lock_free);
+
+    /// CP-SAT only reads the registered flag.
+    mutable std::atomic<bool> mStopRequested = false;
+    /// Time since epoch of Clock, max if no deadline is set.
+    std::atomic<Clock::rep> mDeadline = Clock::duration::max().count();
+};
+
+}
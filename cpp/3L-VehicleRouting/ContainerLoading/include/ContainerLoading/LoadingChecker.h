@@ -5,15 +5,51 @@
 #include "ProblemParameters.h"
 
 #include "Algorithms/MultiContainer/BP_MIP_1D.h"
+#include "Algorithms/SingleContainer/OPP_CP_3D.h"
+#include "Helper/CPModelCache.h"
+#include "Helper/ClockCache.h"
+#include "Helper/CombinationAntichain.h"
+#include "Helper/LoadingCacheCounters.h"
+#include "Helper/PackingCertificateStore.h"
+#include "Helper/PersistentLoadingCache.h"
+#include "Helper/PlacementPatternCache.h"
+#include "Helper/RouteStore.h"
+#include "Helper/SequenceContainmentIndex.h"
+#include "Helper/SetContainmentIndex.h"
+#include "Helper/StopToken.h"
 #include "Model/ContainerLoadingInstance.h"
 
 #include <boost/dynamic_bitset.hpp>
 #include <boost/functional/hash.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <optional>
+
 namespace ContainerLoading
 {
 using namespace Algorithms;
 
+/// One formulation of a route in LoadingChecker::RaceConstraintProgrammingSolvers, arguments as in
+/// ConstraintProgrammingSolver.
+struct CPRaceEntry
+{
+    PackingType Type = PackingType::None;
+    boost::dynamic_bitset<> Set;
+    bool IsCallTypeExact = false;
+    double MaxRuntime = std::numeric_limits<double>::max();
+
+    /// The result settles the race, e.g. infeasibility of a relaxation or feasibility w.r.t. all constraints.
+    bool StopIfInfeasible = true;
+    bool StopIfFeasible = false;
+};
+
+/// Thread-safe after construction: caches may be queried and extended from several threads at once. The cache maps
+/// are keyed by all used masks in the constructor and never change their keys afterwards. Two threads checking the
+/// same route concurrently may both solve it; the second result is ignored.
+/// SetBinPackingModel and EnablePersistentCache must be called before concurrent use.
 class LoadingChecker
 {
   public:
@@ -26,26 +62,52 @@ class LoadingChecker
         std::vector<LoadingFlag> usedLoadingFlags = {Complete, NoSupport, LifoNoSequence};
 
         constexpr size_t reservedSize = 1000;
+        mRouteStore.Reserve(usedLoadingFlags.size() * reservedSize);
         for (const auto flag: usedLoadingFlags)
         {
-            mFeasSequences[flag & Parameters.LoadingProblem.LoadingFlags].reserve(reservedSize);
-            mInfSequences[flag & Parameters.LoadingProblem.LoadingFlags].reserve(reservedSize);
-            mUnkSequences[flag & Parameters.LoadingProblem.LoadingFlags].reserve(reservedSize);
-
-            mFeasibleSets[flag & Parameters.LoadingProblem.LoadingFlags].reserve(reservedSize);
-            mInfSets[flag & Parameters.LoadingProblem.LoadingFlags].reserve(reservedSize);
-            mUnknownSets[flag & Parameters.LoadingProblem.LoadingFlags].reserve(reservedSize);
+            mFeasSequences.try_emplace(flag & Parameters.LoadingProblem.LoadingFlags);
+            mInfSequences.try_emplace(flag & Parameters.LoadingProblem.LoadingFlags);
+            mUnkSequences.try_emplace(flag & Parameters.LoadingProblem.LoadingFlags);
+
+            mFeasibleSets[flag & Parameters.LoadingProblem.LoadingFlags].Reserve(reservedSize);
+            mInfSets[flag & Parameters.LoadingProblem.LoadingFlags].Reserve(reservedSize);
+            mUnknownSets.try_emplace(flag & Parameters.LoadingProblem.LoadingFlags);
+
+            // Without support, feasibility is monotone w.r.t. subsequences of a route.
+            const auto mask = flag & Parameters.LoadingProblem.LoadingFlags;
+            if (IsSet(mask, Sequence) && !IsSet(mask, Support))
+            {
+                mFeasSequenceIndex.try_emplace(mask);
+                mInfSequenceIndex.try_emplace(mask);
+            }
+
+            if (std::ranges::find(mUsedLoadingMasks, mask) == std::end(mUsedLoadingMasks))
+            {
+                mUsedLoadingMasks.push_back(mask);
+            }
         }
+
+        SetMemoryBudgets();
+        mCPModels.SetCapacity(static_cast<size_t>(std::max(Parameters.CPSolver.ReusableModels, 0)));
     }
 
     [[nodiscard]] std::vector<Cuboid>
         SelectItems(const Collections::IdVector& nodeIds, std::vector<Group>& nodes, bool reversedDirection) const;
 
+    /// FeasOpt if a packing is known or found by the extreme point heuristic, otherwise Infeasible. Infeasible is no
+    /// proof: callers comparing with Infeasible run their CP checks (e.g. the relaxations in the infeasible path
+    /// procedure) afterwards.
     [[nodiscard]] LoadingStatus PackingHeuristic(PackingType packingType,
                                                  const Container& container,
                                                  const Collections::IdVector& stopIds,
                                                  const std::vector<Cuboid>& items);
 
+    /// Deadline and stop request of the run. All CP solves except ConstraintProgrammingSolverGetPacking end at the
+    /// deadline, solves stopped before their time limit are not cached. After the stop, CP calls return Invalid (see
+    /// maxRuntime) if the route is not cached.
+    [[nodiscard]] StopToken& GetStopToken() { return mStopToken; }
+    [[nodiscard]] const StopToken& GetStopToken() const { return mStopToken; }
+
     [[nodiscard]] LoadingStatus ConstraintProgrammingSolver(PackingType packingType,
                                                             const Container& container,
                                                             const boost::dynamic_bitset<>& set,
@@ -54,12 +116,31 @@ class LoadingChecker
                                                             bool isCallTypeExact,
                                                             double maxRuntime = std::numeric_limits<double>::max());
 
+    /// Solves the formulations of the route concurrently, each with an equal share of the CP-SAT workers. The remaining
+    /// solves are stopped as soon as one result settles the race (see CPRaceEntry). Statuses are indexed as entries,
+    /// stopped solves are Unknown and not cached.
+    [[nodiscard]] std::vector<LoadingStatus> RaceConstraintProgrammingSolvers(const std::vector<CPRaceEntry>& entries,
+                                                                              const Container& container,
+                                                                              const Collections::IdVector& stopIds,
+                                                                              const std::vector<Cuboid>& items);
+
+    /// Packing of a route of the final solution, only bounded by maxRuntime and not by the stop token.
     [[nodiscard]] LoadingStatus ConstraintProgrammingSolverGetPacking(PackingType packingType,
                                                                       const Container& container,
                                                                       const Collections::IdVector& stopIds,
                                                                       std::vector<Cuboid>& items,
                                                                       double maxRuntime) const;
 
+    /// Customers of the route (in route order) whose items alone cannot be packed w.r.t. the mask of packingType. Found
+    /// in one CP solve with an assumption literal per customer, not necessarily minimal. Empty if the route is not
+    /// proven infeasible within maxRuntime. The route and the core are added to the infeasible caches.
+    [[nodiscard]] Collections::IdVector DetermineInfeasibleCore(PackingType packingType,
+                                                                const Container& container,
+                                                                const boost::dynamic_bitset<>& set,
+                                                                const Collections::IdVector& stopIds,
+                                                                const std::vector<Cuboid>& items,
+                                                                double maxRuntime);
+
     [[nodiscard]] LoadingStatus HeuristicCompleteCheck(const Container& container,
                                                        const boost::dynamic_bitset<>& set,
                                                        const Collections::IdVector& stopIds,
@@ -83,71 +164,173 @@ class LoadingChecker
     [[nodiscard]] bool CustomerCombinationInfeasible(const boost::dynamic_bitset<>& customersInRoute) const;
     void AddInfeasibleCombination(const boost::dynamic_bitset<>& customersInRoute);
 
-    [[nodiscard]] Collections::SequenceVector GetFeasibleRoutes() const;
+    /// Feasible routes are only appended and keep their index -> the number of routes serves as version.
+    /// Returns the routes with index >= firstIndex, i.e. all routes added since version firstIndex.
+    [[nodiscard]] Collections::SequenceVector GetFeasibleRoutes(size_t firstIndex = 0) const;
     [[nodiscard]] size_t GetNumberOfFeasibleRoutes() const;
     [[nodiscard]] size_t GetSizeInfeasibleCombinations() const;
+    [[nodiscard]] CombinationAntichainStatistics GetInfeasibleCombinationStatistics() const;
 
     void AddFeasibleSequenceFromOutside(const Collections::IdVector& route);
 
     [[nodiscard]] bool RouteIsInFeasSequences(const Collections::IdVector& route) const;
 
+    /// Sets the positions of items (selected for route, see SelectItems) to the packing found when route was proven
+    /// feasible w.r.t. all loading constraints. Returns false if no packing is stored.
+    [[nodiscard]] bool GetPackingCertificate(const Collections::IdVector& route, std::vector<Cuboid>& items) const;
+
     void AddSequenceCheckedTwoOpt(const Collections::IdVector& sequence);
 
     [[nodiscard]] bool SequenceIsCheckedTwoOpt(const Collections::IdVector& sequence) const;
 
     [[nodiscard]] boost::dynamic_bitset<> MakeBitset(size_t size, const Collections::IdVector& sequence) const;
 
+    [[nodiscard]] std::vector<LoadingCacheStatistics> GetCacheStatistics() const;
+    [[nodiscard]] const LoadingCacheCounters& GetCacheCounters() const;
+
+    /// Import results of previous runs from filePath and record new results from now on. Returns the number of imported
+    /// results.
+    size_t EnablePersistentCache(const std::string& filePath, uint64_t key);
+    /// Append results recorded since the last call to the persistent cache file.
+    void SavePersistentCache();
+
   private:
+    StopToken mStopToken;
+
     std::unique_ptr<BinPacking1D> mBinPacking1D;
+    /// The Gurobi model of the 1D bin packing is modified in each resolve.
+    mutable std::mutex mBinPackingMutex;
+
+    /// Pinned sequence caches store handles of routes interned in mRouteStore.
+    RouteStore mRouteStore;
 
-    Collections::SequenceSet mTwoOptCheckedSequences;
+    /// Heuristic and unknown results are cheap to recompute -> memory-bounded and not interned.
+    SequenceClockCache mTwoOptCheckedSequences;
 
-    Collections::SequenceSet mEPHeurInfSequences;
-    Collections::SequenceVector mCompleteFeasSeq;
+    SequenceClockCache mEPHeurInfSequences;
+    /// Routes feasible w.r.t. all loading constraints in order of insertion.
+    std::vector<RouteHandle> mCompleteFeasSeq;
+    mutable std::mutex mCompleteFeasSeqMutex;
+
+    /// Packings of routes in mCompleteFeasSeq found by the heuristic or CP, routes added otherwise have none.
+    PackingCertificateStore mPackingCertificates;
 
     /// Set of customer combinations that are infeasible.
     /// -> There is no path in combination C that respects all constraints
     /// -> At least 2 vehicles are needed to serve all customers in C
-    std::vector<boost::dynamic_bitset<>> mInfeasibleCustomerCombinations;
+    /// Only inclusion-minimal combinations are kept, supersets are implied.
+    CombinationAntichain mInfeasibleCustomerCombinations;
+
+    std::unordered_map<LoadingFlag, SetContainmentIndex> mFeasibleSets;
+    std::unordered_map<LoadingFlag, RouteSet> mFeasSequences;
+
+    std::unordered_map<LoadingFlag, SetContainmentIndex> mInfSets;
+    std::unordered_map<LoadingFlag, RouteSet> mInfSequences;
+
+    /// Only for masks with sequence but without support: subsequences of feasible sequences are feasible,
+    /// supersequences of infeasible sequences are infeasible.
+    std::unordered_map<LoadingFlag, SequenceContainmentIndex> mFeasSequenceIndex;
+    std::unordered_map<LoadingFlag, SequenceContainmentIndex> mInfSequenceIndex;
+
+    /// Unknown results store the time already spent -> resolved with escalated time limits.
+    std::unordered_map<LoadingFlag, UnknownSetCache> mUnknownSets;
+    std::unordered_map<LoadingFlag, UnknownSequenceCache> mUnkSequences;
+
+    /// Distinct masks of all packing types, each CP model in mCPModels is built for all of them.
+    std::vector<LoadingFlag> mUsedLoadingMasks;
+    /// A route is often checked with several masks (relaxations first) -> its CP model is kept and solved again.
+    CPModelCache mCPModels;
+    /// The same customers recur in many routes -> placement patterns of their items are shared by all CP models.
+    mutable PlacementPatternCache mPlacementPatterns;
+
+    /// Updated in const lookups.
+    mutable LoadingCacheCounters mCacheCounters;
 
-    std::unordered_map<LoadingFlag, std::vector<boost::dynamic_bitset<>>> mFeasibleSets;
-    std::unordered_map<LoadingFlag, Collections::SequenceSet> mFeasSequences;
+    std::unique_ptr<PersistentLoadingCache> mPersistentCache;
+    std::vector<PersistentLoadingEntry> mNewPersistentEntries;
+    std::mutex mNewPersistentEntriesMutex;
 
-    std::unordered_map<LoadingFlag, std::vector<boost::dynamic_bitset<>>> mInfSets;
-    std::unordered_map<LoadingFlag, Collections::SequenceSet> mInfSequences;
+    void SetMemoryBudgets();
 
-    std::unordered_map<LoadingFlag, std::vector<boost::dynamic_bitset<>>> mUnknownSets;
-    std::unordered_map<LoadingFlag, Collections::SequenceSet> mUnkSequences;
+    [[nodiscard]] bool RouteSetContains(const RouteSet& routes, const Collections::IdVector& sequence) const;
 
     [[nodiscard]] bool SequenceIsHeuristicallyInfeasibleEP(const Collections::IdVector& sequence) const;
     void AddInfeasibleSequenceEP(const Collections::IdVector& sequence);
 
-    void AddFeasibleRoute(const Collections::IdVector& route);
+    /// Dominated routes are implied by the sequence index and not added to it.
+    void AddFeasibleRoute(const Collections::IdVector& route, bool isDominated = false);
+    void AddPackingCertificate(const Collections::IdVector& route, const std::vector<Cuboid>& packedItems);
+    /// Placements of items (selected for route) taken from the certificate of a related route that shares the most
+    /// items: reversed route, route without one customer, last certified routes of its customers. Linear in the route
+    /// length, stops at the first certificate that covers all items. Empty if no related certificate exists.
+    [[nodiscard]] std::vector<std::optional<PlacementHint>> DetermineSolutionHint(const Collections::IdVector& route,
+                                                                                  const std::vector<Cuboid>& items) const;
+    void AddToSequenceIndex(std::unordered_map<LoadingFlag, SequenceContainmentIndex>& indices,
+                            const Collections::IdVector& sequence,
+                            LoadingFlag mask);
 
     [[nodiscard]] bool SequenceIsInfeasibleCP(const Collections::IdVector& sequence, LoadingFlag mask) const;
-    [[nodiscard]] bool SequenceIsUnknownCP(const Collections::IdVector& sequence, LoadingFlag mask) const;
+    [[nodiscard]] bool
+        SequenceIsUnknownCP(const Collections::IdVector& sequence, LoadingFlag mask, double timeBudget) const;
     [[nodiscard]] bool SequenceIsFeasible(const Collections::IdVector& sequence, LoadingFlag mask) const;
+    [[nodiscard]] bool SequenceIsDominatedInfeasibleCP(const Collections::IdVector& sequence, LoadingFlag mask) const;
+    [[nodiscard]] bool SequenceIsDominatedFeasible(const Collections::IdVector& sequence, LoadingFlag mask) const;
 
     [[nodiscard]] bool SetIsInfeasibleCP(const boost::dynamic_bitset<>& set, LoadingFlag mask) const;
-    [[nodiscard]] bool SetIsUnknownCP(const boost::dynamic_bitset<>& set, LoadingFlag mask) const;
+    [[nodiscard]] bool SetIsUnknownCP(const boost::dynamic_bitset<>& set, LoadingFlag mask, double timeBudget) const;
+
+    [[nodiscard]] bool IsUnknownWithinBudget(const std::optional<UnknownLoadingResult>& result, double timeBudget) const;
+    [[nodiscard]] static UnknownLoadingResult AddUnknownCall(UnknownLoadingResult result, double timeBudget);
     [[nodiscard]] bool SetIsFeasibleCP(const boost::dynamic_bitset<>& set, LoadingFlag mask) const;
 
     [[nodiscard]] LoadingFlag BuildMask(PackingType type) const;
 
+    /// Status from the caches or a violated geometric bound, Invalid if the route must be solved.
+    [[nodiscard]] LoadingStatus GetPrecheckStatusWithBounds(const Container& container,
+                                                            const boost::dynamic_bitset<>& set,
+                                                            const Collections::IdVector& stopIds,
+                                                            const std::vector<Cuboid>& items,
+                                                            LoadingFlag mask,
+                                                            bool isCallTypeExact,
+                                                            double maxRuntime);
+    /// Caches the status of a solve of containerLoadingCP and the packing if it is feasible w.r.t. all constraints.
+    [[nodiscard]] LoadingStatus AddSolveStatus(const ContainerLoadingCP& containerLoadingCP,
+                                               const boost::dynamic_bitset<>& set,
+                                               const Collections::IdVector& stopIds,
+                                               const std::vector<Cuboid>& items,
+                                               LoadingFlag mask,
+                                               LoadingStatus status,
+                                               bool isCallTypeExact,
+                                               double maxRuntime);
+    [[nodiscard]] LoadingStatus SolveRaceEntry(const CPRaceEntry& entry,
+                                               const Container& container,
+                                               const Collections::IdVector& stopIds,
+                                               const std::vector<Cuboid>& items,
+                                               int threads,
+                                               std::atomic<bool>& stopFlag);
+
     [[nodiscard]] LoadingStatus GetPrecheckStatusCP(const Collections::IdVector& sequence,
                                                     const boost::dynamic_bitset<>& set,
                                                     LoadingFlag mask,
-                                                    bool isCallTypeExact);
+                                                    bool isCallTypeExact,
+                                                    double timeBudget);
 
     void AddStatus(const Collections::IdVector& sequence,
                    const boost::dynamic_bitset<>& set,
                    LoadingFlag mask,
-                   LoadingStatus status);
+                   LoadingStatus status,
+                   double timeBudget);
+
+    void RecordPersistentEntry(const Collections::IdVector& sequence,
+                               const boost::dynamic_bitset<>& set,
+                               LoadingFlag mask,
+                               LoadingStatus status,
+                               double timeBudget);
 
     [[nodiscard]] LoadingStatus RunLoadingHeuristic(PackingType packingType,
-                                                    const Container& container [[maybe_unused]],
-                                                    const Collections::IdVector& stopIds [[maybe_unused]],
-                                                    const std::vector<Cuboid>& items [[maybe_unused]]);
+                                                    const Container& container,
+                                                    const Collections::IdVector& stopIds,
+                                                    const std::vector<Cuboid>& items);
 
     [[nodiscard]] int DetermineMinVehiclesBinPacking(bool enableLifting,
                                                      double liftingThreshold,
@@ -164,11 +164,32 @@ struct BranchAndCutParameters
     };
 };
 
+/// Memory budgets in MB for cached results that are cheap to recompute. Entries are evicted if a budget is exceeded,
+/// 0 disables eviction. Proven feasible and infeasible results are never evicted.
+struct LoadingCacheParams
+{
+    /// Results of CP calls that hit the time limit (sequences and sets of all masks).
+    double MaxMemoryUnknown = 0.0;
+    /// Sequences that were already improved by 2-opt.
+    double MaxMemoryTwoOptChecked = 0.0;
+    /// Sequences for which the loading heuristic failed.
+    double MaxMemoryHeuristicInfeasible = 0.0;
+    /// Placement patterns of item sets, reused when building CP models.
+    double MaxMemoryPlacementPatterns = 0.0;
+
+    /// A sequence or set with unknown result is solved again only if the new time limit is at least this factor times
+    /// the largest time limit already spent on it.
+    double UnknownEscalationFactor = 2.0;
+    /// Total time limit in seconds that is spent on a sequence or set over all calls with unknown result.
+    double MaxTotalTimeUnknown = std::numeric_limits<double>::max();
+};
+
 struct ContainerLoadingParams
 {
     CPSolverParams CPSolver;
     LoadingProblemParams LoadingProblem;
     BranchAndCutParameters BranchAndCut;
+    LoadingCacheParams LoadingCache;
 
    [[nodiscard]] double DetermineMaxRuntime(BranchAndCutParameters::CallType callType,
                                double residualTime = std::numeric_limits<double>::max()) const
@@ -1,12 +1,252 @@
 #include "Algorithms/PlacementPoints.h"
 
+#include <algorithm>
+#include <bit>
 #include <iostream>
+#include <map>
+#include <optional>
+#include <tuple>
+
 namespace ContainerLoading
 {
 using namespace Model;
 
 namespace Algorithms
 {
+namespace
+{
+using Block = boost::dynamic_bitset<>::block_type;
+constexpr size_t BitsPerBlock = boost::dynamic_bitset<>::bits_per_block;
+
+/// Lengths of an item along axis in both horizontal orientations, equal if the item cannot be rotated.
+std::tuple<int, int> AxisLengths(const Cuboid& item, Axis axis)
+{
+    switch (axis)
+    {
+        case Axis::X:
+            return {item.Dx, item.EnableHorizontalRotation ? item.Dy : item.Dx};
+        case Axis::Y:
+            return {item.Dy, item.EnableHorizontalRotation ? item.Dx : item.Dy};
+        case Axis::Z:
+            return {item.Dz, item.Dz};
+        default:
+            throw std::runtime_error("Undefined axis.");
+    }
+}
+
+std::vector<std::tuple<int, int>> AxisLengths(const std::vector<Cuboid>& items, Axis axis)
+{
+    std::vector<std::tuple<int, int>> lengths;
+    lengths.reserve(items.size());
+    for (const auto& item: items)
+    {
+        lengths.push_back(AxisLengths(item, axis));
+    }
+
+    return lengths;
+}
+
+/// Coordinates in [0, limit] that are reachable by a subset of items placed one after another (subset sums of item
+/// lengths). Coordinates are stored in blocks, adding an item is a shift-or of whole blocks instead of a loop over
+/// single coordinates.
+class SubsetSums
+{
+  public:
+    /// Only coordinate 0 (empty subset) is reachable. Requires limit >= 0.
+    explicit SubsetSums(int limit) : mLimit(limit), mBlocks(static_cast<size_t>(limit) / BitsPerBlock + 1, 0)
+    {
+        mBlocks.front() = 1;
+    }
+
+    /// Add an item that is placed with one of the lengths. Each item is used at most once: blocks are updated from the
+    /// highest to the lowest, so the lower blocks that are shifted into a block are not yet updated.
+    void Add(int firstLength, int secondLength)
+    {
+        for (size_t b = mBlocks.size(); b-- > 0;)
+        {
+            mBlocks[b] |= ShiftedBlock(mBlocks, b, firstLength) | ShiftedBlock(mBlocks, b, secondLength);
+        }
+
+        ClearAboveLimit();
+    }
+
+    /// Sums a + b <= limit with a of this and b of other.
+    [[nodiscard]] SubsetSums Combine(const SubsetSums& other) const
+    {
+        // Both contain coordinate 0 -> the denser set is shifted by each coordinate of the sparser one.
+        const auto& dense = Count() >= other.Count() ? *this : other;
+        const auto& sparse = Count() >= other.Count() ? other : *this;
+
+        auto sums = dense;
+        for (int p = 1; p <= mLimit; ++p)
+        {
+            if (!sparse.Contains(p))
+            {
+                continue;
+            }
+
+            for (size_t b = 0; b < sums.mBlocks.size(); ++b)
+            {
+                sums.mBlocks[b] |= ShiftedBlock(dense.mBlocks, b, p);
+            }
+        }
+
+        sums.ClearAboveLimit();
+        return sums;
+    }
+
+    /// Coordinates in [0, min(limit, size - 1)] as bitset of size.
+    [[nodiscard]] boost::dynamic_bitset<> ToBitset(int limit, size_t size) const
+    {
+        auto blocks = mBlocks;
+        ClearAbove(blocks, limit);
+
+        boost::dynamic_bitset<> coordinates(std::begin(blocks), std::end(blocks));
+        coordinates.resize(size);
+        return coordinates;
+    }
+
+  private:
+    int mLimit;
+    std::vector<Block> mBlocks;
+
+    [[nodiscard]] bool Contains(int p) const { return (mBlocks[p / BitsPerBlock] >> (p % BitsPerBlock)) & Block(1); }
+
+    [[nodiscard]] size_t Count() const
+    {
+        size_t count = 0;
+        for (const auto block: mBlocks)
+        {
+            count += std::popcount(block);
+        }
+
+        return count;
+    }
+
+    void ClearAboveLimit() { ClearAbove(mBlocks, mLimit); }
+
+    /// Block b of the coordinates shifted by length.
+    [[nodiscard]] static Block ShiftedBlock(const std::vector<Block>& blocks, size_t b, int length)
+    {
+        const auto blockShift = static_cast<size_t>(length) / BitsPerBlock;
+        const auto bitShift = static_cast<size_t>(length) % BitsPerBlock;
+        if (blockShift > b)
+        {
+            return 0;
+        }
+
+        auto shifted = blocks[b - blockShift] << bitShift;
+        if (bitShift > 0 && b > blockShift)
+        {
+            shifted |= blocks[b - blockShift - 1] >> (BitsPerBlock - bitShift);
+        }
+
+        return shifted;
+    }
+
+    static void ClearAbove(std::vector<Block>& blocks, int limit)
+    {
+        if (limit < 0)
+        {
+            std::ranges::fill(blocks, 0);
+            return;
+        }
+
+        const auto lastBlock = static_cast<size_t>(limit) / BitsPerBlock;
+        const auto lastBit = static_cast<size_t>(limit) % BitsPerBlock;
+        for (size_t b = lastBlock + 1; b < blocks.size(); ++b)
+        {
+            blocks[b] = 0;
+        }
+
+        if (lastBlock < blocks.size() && lastBit + 1 < BitsPerBlock)
+        {
+            blocks[lastBlock] &= (Block(1) << (lastBit + 1)) - 1;
+        }
+    }
+};
+
+/// representatives[i] is the first item with the same dimensions and rotation as item i. Placement patterns only depend
+/// on these properties of the item and of all other items -> identical items have identical patterns.
+std::vector<size_t> DetermineRepresentatives(const std::vector<Cuboid>& items)
+{
+    std::map<std::tuple<int, int, int, bool>, size_t> firstItems;
+
+    std::vector<size_t> representatives;
+    representatives.reserve(items.size());
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const auto& item = items[i];
+        const auto [it, inserted] =
+            firstItems.try_emplace(std::make_tuple(item.Dx, item.Dy, item.Dz, item.EnableHorizontalRotation), i);
+        representatives.push_back(it->second);
+    }
+
+    return representatives;
+}
+
+/// otherItemSums[i] are the subset sums of all items except item i. Combines the sums of the items before and after i
+/// instead of recomputing the sums of n - 1 items for each i. Items with equal lengths have equal sums.
+std::vector<SubsetSums> DetermineOtherItemSums(const std::vector<std::tuple<int, int>>& lengths, int limit)
+{
+    // prefixSums[i] are the subset sums of items [0, i).
+    std::vector<SubsetSums> prefixSums;
+    prefixSums.reserve(lengths.size());
+    prefixSums.emplace_back(limit);
+    for (size_t i = 1; i < lengths.size(); ++i)
+    {
+        prefixSums.push_back(prefixSums.back());
+        prefixSums.back().Add(std::get<0>(lengths[i - 1]), std::get<1>(lengths[i - 1]));
+    }
+
+    std::vector<SubsetSums> otherItemSums;
+    otherItemSums.reserve(lengths.size());
+
+    // Last item with the same lengths, its sums are computed first.
+    std::map<std::tuple<int, int>, size_t> lastItems;
+    std::vector<size_t> representatives(lengths.size());
+    for (size_t i = lengths.size(); i-- > 0;)
+    {
+        representatives[i] = lastItems.try_emplace(lengths[i], i).first->second;
+    }
+
+    // Subset sums of items (i, n).
+    SubsetSums suffixSums(limit);
+    for (size_t i = lengths.size(); i-- > 0;)
+    {
+        if (representatives[i] == i)
+        {
+            otherItemSums.push_back(prefixSums[i].Combine(suffixSums));
+        }
+        else
+        {
+            otherItemSums.push_back(otherItemSums[lengths.size() - 1 - representatives[i]]);
+        }
+
+        suffixSums.Add(std::get<0>(lengths[i]), std::get<1>(lengths[i]));
+    }
+
+    std::ranges::reverse(otherItemSums);
+    return otherItemSums;
+}
+
+/// Coordinates of subsetSums in [0, limit], empty if limit < 0.
+boost::dynamic_bitset<> TruncateSubsetSums(const boost::dynamic_bitset<>& subsetSums, int limit)
+{
+    auto coordinates = subsetSums;
+    if (limit < 0)
+    {
+        coordinates.reset();
+    }
+    else if (static_cast<size_t>(limit) + 1 < coordinates.size())
+    {
+        coordinates.reset(limit + 1, coordinates.size() - limit - 1);
+    }
+
+    return coordinates;
+}
+}
+
 std::tuple<std::vector<int64>, std::vector<int64>, std::vector<int64>>
     PlacementPointGenerator::DetermineMeetInTheMiddlePatterns(const Container& container, std::vector<Cuboid>& items)
 {
@@ -163,40 +403,21 @@ std::vector<boost::dynamic_bitset<>> PlacementPointGenerator::DetermineMinimalMe
     MeetInTheMiddleMinimizationTarget minimizationTarget,
     Axis axis)
 {
-    std::vector<boost::dynamic_bitset<>> regularNormalPatterns;
-    regularNormalPatterns.reserve(items.size());
+    const std::vector<boost::dynamic_bitset<>> regularNormalPatterns =
+        GenerateRegularNormalPatterns(container, items, axis);
 
     std::vector<int> meetInTheMiddlePointsLeft(container.Dimension(axis) + 1, 0);
     std::vector<int> meetInTheMiddlePointsRight(container.Dimension(axis) + 1, 0);
 
     for (size_t i = 0; i < items.size(); ++i)
     {
-        const Cuboid& itemI = items[i];
-
-        std::vector<Cuboid*> filteredItems;
-        filteredItems.reserve(items.size() - 1);
-
-        for (size_t j = 0; j < items.size(); j++)
-        {
-            if (i == j)
-            {
-                continue;
-            }
-
-            Cuboid& itemJ = items[j];
-
-            filteredItems.emplace_back(&itemJ);
-        }
-
-        boost::dynamic_bitset<> regularNormalPattern = DetermineRegularNormalPatterns(container,
-                                                                                      filteredItems,
-                                                                                      itemI,
-                                                                                      meetInTheMiddlePointsLeft,
-                                                                                      meetInTheMiddlePointsRight,
-                                                                                      minimizationTarget,
-                                                                                      axis);
-
-        regularNormalPatterns.emplace_back(std::move(regularNormalPattern));
+        CountRegularNormalPatterns(container,
+                                   regularNormalPatterns[i],
+                                   items[i],
+                                   meetInTheMiddlePointsLeft,
+                                   meetInTheMiddlePointsRight,
+                                   minimizationTarget,
+                                   axis);
     }
 
     // Determine cumulative placement points.
@@ -278,65 +499,64 @@ std::vector<boost::dynamic_bitset<>>
     itemSpecificPlacementPointsLeft.reserve(items.size());
     itemSpecificPlacementPointsRightPrime.reserve(items.size());
 
+    // Subset sums of all items except i (filtered), and of all items except i and the minimal item (doubly filtered).
+    const auto containerDimension = container.Dimension(axis);
+    auto lengths = AxisLengths(items, axis);
+    const auto otherItemSums = DetermineOtherItemSums(lengths, containerDimension);
+    lengths.erase(std::begin(lengths) + minimalItemIndex);
+    const auto otherItemSumsWithoutMinimal = DetermineOtherItemSums(lengths, containerDimension);
+
+    // Patterns are determined once per class of identical items. The minimal item forms its own class, its doubly
+    // filtered item set differs from the one of identical items.
+    auto representatives = DetermineRepresentatives(items);
+    const auto minimalItem = static_cast<size_t>(minimalItemIndex);
+    std::optional<size_t> minimalItemCopy;
+    for (size_t i = minimalItem + 1; i < items.size(); i++)
+    {
+        if (representatives[i] == minimalItem)
+        {
+            representatives[i] = minimalItemCopy.value_or(i);
+            minimalItemCopy = representatives[i];
+        }
+    }
+
     // Determine left and right patterns. If Proposition 5 is enabled, with additionally reduced items sets. If it is
     // disabled with the standard item set resp. the standard meet-in-the-middle procedure, cp. Algorithm 2 in the
     // paper.
     for (size_t i = 0; i < items.size(); i++)
     {
+        if (representatives[i] != i)
+        {
+            itemSpecificPlacementPointsLeft.push_back(itemSpecificPlacementPointsLeft[representatives[i]]);
+            itemSpecificPlacementPointsRightPrime.push_back(itemSpecificPlacementPointsRightPrime[representatives[i]]);
+            continue;
+        }
+
         const Cuboid& item = items[i];
         int minSelectedItemDimension = item.MinimumRotatableDimension(axis);
 
         boost::dynamic_bitset<> placementPointsLeft;
         boost::dynamic_bitset<> placementPointsRightPrime;
 
-        std::vector<Cuboid*> filteredItems;
-        std::vector<Cuboid*> doublyFilteredItems;
-        filteredItems.reserve(items.size() - 1);
-        doublyFilteredItems.reserve(items.size() - 1);
+        const auto filteredItemSums = otherItemSums[i].ToBitset(containerDimension, containerDimension + 1);
 
-        for (size_t k = 0; k < items.size(); k++)
+        // Do not filter k == minimalItemIndex if Proposition 5 is disabled, s.t. doublyFilteredItems is only reduced by
+        // i, as in the normal procedure.
+        auto doublyFilteredItemSums = filteredItemSums;
+        if (enablePreprocessingStep1 && i != minimalItem)
         {
-            if (k == i)
-            {
-                // Do not filter k == minimalItemIndex if Proposition 5 is disabled, s.t. doublyFilteredItems is only
-                // reduced by i, as in the normal procedure.
-                continue;
-            }
-
-            filteredItems.emplace_back(&items[k]);
-
-            if (k == minimalItemIndex)
-            {
-                continue;
-            }
-
-            doublyFilteredItems.emplace_back(&items[k]);
+            const auto k = i < minimalItem ? i : i - 1;
+            doublyFilteredItemSums = otherItemSumsWithoutMinimal[k].ToBitset(containerDimension, containerDimension + 1);
         }
 
-        if (!enablePreprocessingStep1)
-        {
-            DetermineSingleItemReducedLeftRightPatterns(threshold,
-                                                        separationThreshold,
-                                                        placementPointsLeft,
-                                                        container,
-                                                        axis,
-                                                        minSelectedItemDimension,
-                                                        filteredItems,
-                                                        placementPointsRightPrime,
-                                                        filteredItems);
-        }
-        else
-        {
-            DetermineSingleItemReducedLeftRightPatterns(threshold,
-                                                        separationThreshold,
-                                                        placementPointsLeft,
-                                                        container,
-                                                        axis,
-                                                        minSelectedItemDimension,
-                                                        doublyFilteredItems,
-                                                        placementPointsRightPrime,
-                                                        filteredItems);
-        }
+        DetermineSingleItemReducedLeftRightPatterns(threshold,
+                                                    separationThreshold,
+                                                    placementPointsLeft,
+                                                    containerDimension,
+                                                    minSelectedItemDimension,
+                                                    doublyFilteredItemSums,
+                                                    placementPointsRightPrime,
+                                                    filteredItemSums);
 
         itemSpecificPlacementPointsLeft.emplace_back(std::move(placementPointsLeft));
         itemSpecificPlacementPointsRightPrime.emplace_back(std::move(placementPointsRightPrime));
@@ -349,6 +569,13 @@ std::vector<boost::dynamic_bitset<>>
 
     for (size_t i = 0; i < items.size(); i++)
     {
+        if (representatives[i] != i)
+        {
+            itemSpecificPlacementPointsRight.push_back(itemSpecificPlacementPointsRight[representatives[i]]);
+            itemSpecificMeetInTheMiddleSets.push_back(itemSpecificMeetInTheMiddleSets[representatives[i]]);
+            continue;
+        }
+
         const Cuboid& itemI = items[i];
         const int minItemDimensionI = itemI.MinimumRotatableDimension(axis);
 
@@ -394,6 +621,7 @@ std::vector<boost::dynamic_bitset<>>
 
     // Proposition 6 for left.
     DetermineEnlargedItemDimensionsLeft(items,
+                                        representatives,
                                         axis,
                                         itemSpecificModifiedItemDimensions,
                                         itemSpecificPlacementPointsLeft,
@@ -402,6 +630,7 @@ std::vector<boost::dynamic_bitset<>>
 
     // Proposition 6 for right.
     DetermineEnlargedItemDimensionsRight(items,
+                                         representatives,
                                          axis,
                                          itemSpecificModifiedItemDimensions,
                                          itemSpecificPlacementPointsRight,
@@ -415,7 +644,7 @@ std::vector<boost::dynamic_bitset<>>
     }
 
     // Proposition 7
-    RemoveRedundantPatterns(items, itemSpecificModifiedItemDimensions, itemSpecificMeetInTheMiddleSets);
+    RemoveRedundantPatterns(items, representatives, itemSpecificModifiedItemDimensions, itemSpecificMeetInTheMiddleSets);
 
     return itemSpecificMeetInTheMiddleSets;
 }
@@ -424,28 +653,22 @@ void PlacementPointGenerator::DetermineSingleItemReducedLeftRightPatterns(
     int threshold,
     int separationThreshold,
     boost::dynamic_bitset<>& placementPointsLeft,
-    const Container& container,
-    Axis axis,
+    int containerDimension,
     int minSelectedItemDimension,
-    const std::vector<Cuboid*>& doublyFilteredItems,
+    const boost::dynamic_bitset<>& doublyFilteredItemSums,
     boost::dynamic_bitset<>& placementPointsRightPrime,
-    const std::vector<Cuboid*>& filteredItems)
+    const boost::dynamic_bitset<>& filteredItemSums)
 {
-    std::vector<Cuboid*> filteredItemsA;
-    std::vector<Cuboid*> filteredItemsB;
+    // Remove item k from left.
+    const boost::dynamic_bitset<>* itemSumsA = &filteredItemSums;
+    const boost::dynamic_bitset<>* itemSumsB = &doublyFilteredItemSums;
 
-    if (threshold <= separationThreshold)
-    {
-        // Remove item k from left.
-        filteredItemsA = filteredItems;
-        filteredItemsB = doublyFilteredItems;
-    }
-    else
+    if (threshold > separationThreshold)
     {
         // t >= separationThreshold + 1
         // Remove item k from right.
-        filteredItemsA = doublyFilteredItems;
-        filteredItemsB = filteredItems;
+        itemSumsA = &doublyFilteredItemSums;
+        itemSumsB = &filteredItemSums;
 
         // Example 1.
         // Two items with dimensions = {0: 2, 1: 5}. Assume t = container.Dx = 20, so t > separationThreshold = 9. A
@@ -459,45 +682,15 @@ void PlacementPointGenerator::DetermineSingleItemReducedLeftRightPatterns(
         // TODO.Doc: Example with right aligned items that satisfies MiM principle.
     }
 
-    switch (axis)
-    {
-        case Axis::X:
-            placementPointsLeft = DetermineRegularNormalPatternsX(
-                std::min(threshold - 1, container.Dimension(axis) - minSelectedItemDimension),
-                container.Dimension(axis),
-                filteredItemsB);
-            placementPointsRightPrime =
-                DetermineRegularNormalPatternsX(container.Dimension(axis) - minSelectedItemDimension - threshold,
-                                                container.Dimension(axis),
-                                                filteredItemsA);
-            break;
-        case Axis::Y:
-            placementPointsLeft = DetermineRegularNormalPatternsY(
-                std::min(threshold - 1, container.Dimension(axis) - minSelectedItemDimension),
-                container.Dimension(axis),
-                filteredItemsB);
-            placementPointsRightPrime =
-                DetermineRegularNormalPatternsY(container.Dimension(axis) - minSelectedItemDimension - threshold,
-                                                container.Dimension(axis),
-                                                filteredItemsA);
-            break;
-        case Axis::Z:
-            placementPointsLeft = DetermineRegularNormalPatternsZ(
-                std::min(threshold - 1, container.Dimension(axis) - minSelectedItemDimension),
-                container.Dimension(axis),
-                filteredItemsB);
-            placementPointsRightPrime =
-                DetermineRegularNormalPatternsZ(container.Dimension(axis) - minSelectedItemDimension - threshold,
-                                                container.Dimension(axis),
-                                                filteredItemsA);
-            break;
-        default:
-            throw std::runtime_error("Undefined axis.");
-    }
+    placementPointsLeft =
+        TruncateSubsetSums(*itemSumsB, std::min(threshold - 1, containerDimension - minSelectedItemDimension));
+    placementPointsRightPrime =
+        TruncateSubsetSums(*itemSumsA, containerDimension - minSelectedItemDimension - threshold);
 }
 
 void PlacementPointGenerator::DetermineEnlargedItemDimensionsLeft(
     std::vector<Cuboid>& items,
+    const std::vector<size_t>& representatives,
     Axis axis,
     std::vector<std::vector<int>>& itemSpecificModifiedItemDimensions,
     const std::vector<boost::dynamic_bitset<>>& itemSpecificPlacementPointsLeft,
@@ -506,6 +699,13 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsLeft(
 {
     for (size_t k = 0; k < items.size(); k++)
     {
+        // Only depends on the patterns of item k and of all other items, which are equal for identical items.
+        if (representatives[k] != k)
+        {
+            itemSpecificModifiedItemDimensions[k] = itemSpecificModifiedItemDimensions[representatives[k]];
+            continue;
+        }
+
         const Cuboid& itemK = items[k];
         int minSelectedItemDimension = itemK.MinimumRotatableDimension(axis);
 
@@ -514,6 +714,19 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsLeft(
         if (placementPointsLeft.count() == 0)
             continue;
 
+        // Identical items have the same meet-in-the-middle sets -> one item of each class is sufficient for sMin.
+        std::vector<size_t> otherItems;
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            if (i != k
+                && std::ranges::none_of(otherItems,
+                                        [&representatives, i](size_t j)
+                                        { return representatives[j] == representatives[i]; }))
+            {
+                otherItems.push_back(i);
+            }
+        }
+
         for (size_t p = 0, n = placementPointsLeft.size() - minSelectedItemDimension; p < n; p++)
         {
             if (!placementPointsLeft[p])
@@ -523,13 +736,8 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsLeft(
 
             int sMin = container.Dimension(axis);
 
-            for (size_t i = 0; i < items.size(); i++)
+            for (const auto i: otherItems)
             {
-                if (i == k)
-                {
-                    continue;
-                }
-
                 const Cuboid& itemI = items[i];
                 int minSelectedItemDimensionI = itemI.MinimumRotatableDimension(axis);
                 const boost::dynamic_bitset<>& meetInTheMiddlePointsI = preliminaryItemSpecificMeetInTheMiddleSets[i];
@@ -562,6 +770,7 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsLeft(
 
 void PlacementPointGenerator::DetermineEnlargedItemDimensionsRight(
     std::vector<Cuboid>& items,
+    const std::vector<size_t>& representatives,
     Axis axis,
     std::vector<std::vector<int>>& itemSpecificModifiedItemDimensions,
     std::vector<boost::dynamic_bitset<>>& itemSpecificPlacementPointsRight,
@@ -577,6 +786,24 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsRight(
         if (placementPointsRight.count() == 0)
             continue;
 
+        // Items are enlarged one after another, identical items only contribute equally to sMax if their dimensions
+        // have been modified equally so far.
+        std::vector<size_t> otherItems;
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            if (i != k
+                && std::ranges::none_of(otherItems,
+                                        [&representatives, &itemSpecificModifiedItemDimensions, i](size_t j)
+                                        {
+                                            return representatives[j] == representatives[i]
+                                                   && itemSpecificModifiedItemDimensions[j]
+                                                          == itemSpecificModifiedItemDimensions[i];
+                                        }))
+            {
+                otherItems.push_back(i);
+            }
+        }
+
         for (size_t p = 0; p < placementPointsRight.size() - minSelectedItemDimension; p++)
         {
             if (!placementPointsRight[p])
@@ -586,12 +813,8 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsRight(
 
             int sMax = 0;
 
-            for (size_t i = 0; i < items.size(); i++)
+            for (const auto i: otherItems)
             {
-                if (i == k)
-                {
-                    continue;
-                }
                 const Cuboid& itemI = items[i];
                 int minSelectedItemDimensionI = itemI.MinimumRotatableDimension(axis);
                 const boost::dynamic_bitset<>& meetInTheMiddlePointsI = preliminaryItemSpecificMeetInTheMiddleSets[i];
@@ -630,16 +853,32 @@ void PlacementPointGenerator::DetermineEnlargedItemDimensionsRight(
 
 void PlacementPointGenerator::RemoveRedundantPatterns(
     std::vector<Cuboid>& items,
+    const std::vector<size_t>& representatives,
     const std::vector<std::vector<int>>& itemSpecificModifiedItemDimensions,
     std::vector<boost::dynamic_bitset<>>& itemSpecificPlacementPoints)
 {
+    // Inputs of the representative before its patterns are reduced.
+    std::vector<boost::dynamic_bitset<>> unreducedPlacementPoints(items.size());
+
     for (size_t k = 0; k < items.size(); k++)
     {
-        const Cuboid& itemK = items[k];
-
         const std::vector<int>& modifiedItemDimensionsK = itemSpecificModifiedItemDimensions[k];
         boost::dynamic_bitset<>& placementPoints = itemSpecificPlacementPoints[k];
 
+        // Proposition 6 for right is applied item by item, identical items may have different inputs.
+        const auto r = representatives[k];
+        if (r != k && placementPoints == unreducedPlacementPoints[r]
+            && modifiedItemDimensionsK == itemSpecificModifiedItemDimensions[r])
+        {
+            placementPoints = itemSpecificPlacementPoints[r];
+            continue;
+        }
+
+        if (r == k)
+        {
+            unreducedPlacementPoints[k] = placementPoints;
+        }
+
         for (size_t p = 0; p < placementPoints.size() - 1; p++)
         {
             if (!placementPoints[p])
@@ -710,39 +949,19 @@ std::vector<boost::dynamic_bitset<>> PlacementPointGenerator::GenerateMeetInTheM
     return itemSpecificMeetInTheMiddlePoints;
 }
 
-boost::dynamic_bitset<>
-    PlacementPointGenerator::DetermineRegularNormalPatterns(const Container& container,
-                                                            const std::vector<Cuboid*>& items,
-                                                            const Cuboid& itemI,
-                                                            std::vector<int>& meetInTheMiddlePointsLeft,
-                                                            std::vector<int>& meetInTheMiddlePointsRight,
-                                                            MeetInTheMiddleMinimizationTarget minimizationTarget,
-                                                            Axis axis)
+void PlacementPointGenerator::CountRegularNormalPatterns(const Container& container,
+                                                         const boost::dynamic_bitset<>& regularNormalPatterns,
+                                                         const Cuboid& itemI,
+                                                         std::vector<int>& meetInTheMiddlePointsLeft,
+                                                         std::vector<int>& meetInTheMiddlePointsRight,
+                                                         MeetInTheMiddleMinimizationTarget minimizationTarget,
+                                                         Axis axis)
 {
     // Note: with rotation, item specific normal patterns can be reduced by creating item specific normal patterns for
     // each rotation separately. This is only useful, when item specific placement points are actually used in the model
     // formulation.
     int itemDimension = itemI.MinimumRotatableDimension(axis);
 
-    boost::dynamic_bitset<> regularNormalPatterns;
-    switch (axis)
-    {
-        case Axis::X:
-            regularNormalPatterns = DetermineRegularNormalPatternsX(
-                container.Dimension(axis) - itemDimension, container.Dimension(axis), items);
-            break;
-        case Axis::Y:
-            regularNormalPatterns = DetermineRegularNormalPatternsY(
-                container.Dimension(axis) - itemDimension, container.Dimension(axis), items);
-            break;
-        case Axis::Z:
-            regularNormalPatterns = DetermineRegularNormalPatternsZ(
-                container.Dimension(axis) - itemDimension, container.Dimension(axis), items);
-            break;
-        default:
-            break;
-    }
-
     for (size_t p = 0; p < regularNormalPatterns.size(); p++)
     {
         if (regularNormalPatterns[p])
@@ -762,8 +981,6 @@ boost::dynamic_bitset<>
             }
         }
     }
-
-    return regularNormalPatterns;
 }
 
 boost::dynamic_bitset<> PlacementPointGenerator::DetermineMeetInTheMiddlePatterns(const Container& container,
@@ -818,124 +1035,58 @@ boost::dynamic_bitset<> PlacementPointGenerator::DetermineRegularNormalPatternsX
     // + 1 can be neglected, because at coordinate actualContainerDx, no item with itemDx > 0 can ever be placed.
     // boost::dynamic_bitset, because of performance when building set intersections in the calling methods. Instead,
     // std::vector can also be used.
-    boost::dynamic_bitset<> xT(actualContainerDx + 1);
-
     if (containerDx < 0)
     {
-        return xT;
+        return boost::dynamic_bitset<>(actualContainerDx + 1);
     }
 
-    xT.set(0);
-
-    if (containerDx == 0)
+    // p + item.Dx <= containerDx instead of <, cf. Algorithm 1 in Côté, J. F., & Iori, M. (2018). The
+    // meet-in-the-middle principle for cutting and packing problems. INFORMS Journal on Computing, 30(4), 646-661.
+    SubsetSums xT(containerDx);
+    for (const auto* item: items)
     {
-        return xT;
+        const auto [length, rotatedLength] = AxisLengths(*item, Axis::X);
+        xT.Add(length, rotatedLength);
     }
 
-    for (size_t i = 0; i < items.size(); ++i)
-    {
-        const Cuboid& item = *items[i];
-
-        int minLength = item.EnableHorizontalRotation ? std::min(item.Dx, item.Dy) : item.Dx;
-
-        for (int p = containerDx - minLength; p > -1; --p)
-        {
-            if (xT[p])
-            {
-                // + 1 --> p + item.Dx <= containerDx instead of <, cf. Algorithm 1 in Côté, J. F., & Iori, M. (2018).
-                // The meet-in-the-middle principle for cutting and packing problems. INFORMS Journal on Computing,
-                // 30(4), 646-661.
-                if (p + item.Dx <= containerDx)
-                {
-                    xT.set(p + item.Dx);
-                }
-
-                if (item.EnableHorizontalRotation && p + item.Dy <= containerDx)
-                {
-                    xT.set(p + item.Dy);
-                }
-            }
-        }
-    }
-
-    return xT;
+    return xT.ToBitset(containerDx, actualContainerDx + 1);
 }
 
 boost::dynamic_bitset<> PlacementPointGenerator::DetermineRegularNormalPatternsY(int containerDy,
                                                                                  int actualContainerDy,
                                                                                  const std::vector<Cuboid*>& items)
 {
-    boost::dynamic_bitset<> yT(actualContainerDy + 1, 0);
-
     if (containerDy < 0)
     {
-        return yT;
-    }
-
-    yT.set(0);
-
-    if (containerDy == 0)
-    {
-        return yT;
+        return boost::dynamic_bitset<>(actualContainerDy + 1);
     }
 
-    for (size_t i = 0; i < items.size(); ++i)
+    SubsetSums yT(containerDy);
+    for (const auto* item: items)
     {
-        const Cuboid& item = *items[i];
-        int minWidth = item.EnableHorizontalRotation ? std::min(item.Dx, item.Dy) : item.Dy;
-
-        for (int p = containerDy - minWidth; p > -1; --p)
-        {
-            if (yT[p])
-            {
-                if (p + item.Dy <= containerDy)
-                {
-                    yT.set(p + item.Dy);
-                }
-
-                if (item.EnableHorizontalRotation && p + item.Dx <= containerDy)
-                {
-                    yT.set(p + item.Dx);
-                }
-            }
-        }
+        const auto [width, rotatedWidth] = AxisLengths(*item, Axis::Y);
+        yT.Add(width, rotatedWidth);
     }
 
-    return yT;
+    return yT.ToBitset(containerDy, actualContainerDy + 1);
 }
 
 boost::dynamic_bitset<> PlacementPointGenerator::DetermineRegularNormalPatternsZ(int containerDz,
                                                                                  int actualContainerDz,
                                                                                  const std::vector<Cuboid*>& items)
 {
-    boost::dynamic_bitset<> zT(actualContainerDz + 1, 0);
-
     if (containerDz < 0)
     {
-        return zT;
+        return boost::dynamic_bitset<>(actualContainerDz + 1);
     }
 
-    zT.set(0);
-
-    if (containerDz == 0)
+    SubsetSums zT(containerDz);
+    for (const auto* item: items)
     {
-        return zT;
+        zT.Add(item->Dz, item->Dz);
     }
 
-    for (size_t i = 0; i < items.size(); ++i)
-    {
-        const Cuboid& item = *items[i];
-
-        for (int p = containerDz - item.Dz; p > -1; --p)
-        {
-            if (zT[p] && p + item.Dz <= containerDz)
-            {
-                zT.set(p + item.Dz);
-            }
-        }
-    }
-
-    return zT;
+    return zT.ToBitset(containerDz, actualContainerDz + 1);
 }
 
 std::tuple<PlacementPattern, PlacementPattern, PlacementPattern>
@@ -1256,47 +1407,25 @@ std::vector<boost::dynamic_bitset<>> PlacementPointGenerator::GenerateRegularNor
                                                                                             std::vector<Cuboid>& items,
                                                                                             Axis axis)
 {
+    const auto containerDimension = container.Dimension(axis);
+    const auto otherItemSums = DetermineOtherItemSums(AxisLengths(items, axis), containerDimension);
+
     std::vector<boost::dynamic_bitset<>> itemSpecificRegularNormalPatterns;
     itemSpecificRegularNormalPatterns.reserve(items.size());
 
+    const auto representatives = DetermineRepresentatives(items);
     for (size_t i = 0; i < items.size(); i++)
     {
-        const Cuboid itemI = items[i];
-        int itemDimension = itemI.MinimumRotatableDimension(axis);
-
-        std::vector<Cuboid*> filteredItems;
-        filteredItems.reserve(items.size() - 1);
-        for (size_t j = 0; j < items.size(); j++)
+        if (representatives[i] != i)
         {
-            if (i == j)
-            {
-                continue;
-            }
-
-            Cuboid& itemJ = items[j];
-            filteredItems.emplace_back(&itemJ);
+            itemSpecificRegularNormalPatterns.push_back(itemSpecificRegularNormalPatterns[representatives[i]]);
+            continue;
         }
 
-        boost::dynamic_bitset<> regularNormalPatterns;
-        switch (axis)
-        {
-            case Axis::X:
-                regularNormalPatterns = DetermineRegularNormalPatternsX(
-                    container.Dimension(axis) - itemDimension, container.Dimension(axis), filteredItems);
-                break;
-            case Axis::Y:
-                regularNormalPatterns = DetermineRegularNormalPatternsY(
-                    container.Dimension(axis) - itemDimension, container.Dimension(axis), filteredItems);
-                break;
-            case Axis::Z:
-                regularNormalPatterns = DetermineRegularNormalPatternsZ(
-                    container.Dimension(axis) - itemDimension, container.Dimension(axis), filteredItems);
-                break;
-            default:
-                break;
-        }
+        int itemDimension = items[i].MinimumRotatableDimension(axis);
 
-        itemSpecificRegularNormalPatterns.push_back(std::move(regularNormalPatterns));
+        itemSpecificRegularNormalPatterns.push_back(
+            otherItemSums[i].ToBitset(containerDimension - itemDimension, containerDimension + 1));
     }
 
     return itemSpecificRegularNormalPatterns;
@@ -0,0 +1,280 @@
+#include "Algorithms/SingleContainer/GeometricBounds.h"
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+
+namespace ContainerLoading
+{
+using namespace Model;
+
+namespace Algorithms
+{
+namespace
+{
+/// The axis itself and the two other axes.
+constexpr std::array<std::tuple<Axis, Axis, Axis>, 3> AxisTriples = {
+    std::make_tuple(Axis::X, Axis::Y, Axis::Z),
+    std::make_tuple(Axis::Y, Axis::X, Axis::Z),
+    std::make_tuple(Axis::Z, Axis::X, Axis::Y)};
+
+constexpr double Tolerance = 1e-9;
+}
+
+GeometricBound GeometricBounds::FindViolatedBound() const
+{
+    if (mItems.empty())
+    {
+        return GeometricBound::None;
+    }
+
+    if (ItemDimensionsViolated())
+    {
+        return GeometricBound::ItemDimensions;
+    }
+
+    if (LargeItemsViolated())
+    {
+        return GeometricBound::LargeItems;
+    }
+
+    if (DualFeasibleFunctionsViolated())
+    {
+        return GeometricBound::DualFeasibleFunctions;
+    }
+
+    if (FloorAreaViolated())
+    {
+        return GeometricBound::FloorArea;
+    }
+
+    if (CumulativeProfileViolated())
+    {
+        return GeometricBound::CumulativeProfile;
+    }
+
+    return GeometricBound::None;
+}
+
+bool GeometricBounds::ItemDimensionsViolated() const
+{
+    for (const auto& item: mItems)
+    {
+        const auto fitsNotRotated = item.Dx <= mContainer.Dx && item.Dy <= mContainer.Dy;
+        const auto fitsRotated = item.EnableHorizontalRotation && item.Dy <= mContainer.Dx && item.Dx <= mContainer.Dy;
+        if (item.Dz > mContainer.Dz || (!fitsNotRotated && !fitsRotated))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool GeometricBounds::LargeItemsViolated() const
+{
+    for (const auto& [axis, firstOther, secondOther]: AxisTriples)
+    {
+        const auto firstLimit = mContainer.Dimension(firstOther);
+        const auto secondLimit = mContainer.Dimension(secondOther);
+
+        int64_t sumLength = 0;
+        for (const auto& item: mItems)
+        {
+            if (2 * item.MinimumRotatableDimension(firstOther) > firstLimit
+                && 2 * item.MinimumRotatableDimension(secondOther) > secondLimit)
+            {
+                sumLength += item.MinimumRotatableDimension(axis);
+            }
+        }
+
+        if (sumLength > mContainer.Dimension(axis))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool GeometricBounds::DualFeasibleFunctionsViolated() const
+{
+    for (const auto& [axis, firstOther, secondOther]: AxisTriples)
+    {
+        const auto length = mContainer.Dimension(axis);
+
+        // Threshold 0 is the plain volume bound, larger thresholds are only useful at item dimensions.
+        if (DualFeasibleVolume(axis, 0.0) > 1.0 + Tolerance)
+        {
+            return true;
+        }
+
+        for (const auto& item: mItems)
+        {
+            const auto dimension = item.MinimumRotatableDimension(axis);
+            if (2 * dimension > length)
+            {
+                continue;
+            }
+
+            if (DualFeasibleVolume(axis, static_cast<double>(dimension) / length) > 1.0 + Tolerance)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+double GeometricBounds::DualFeasibleVolume(Axis axis, double epsilon) const
+{
+    const auto length = static_cast<double>(mContainer.Dimension(axis));
+
+    double volume = 0.0;
+    for (const auto& item: mItems)
+    {
+        // u(x) = 1 if x > 1 - epsilon, 0 if x < epsilon, x otherwise.
+        const auto relativeDimension = item.MinimumRotatableDimension(axis) / length;
+        double transformedDimension = relativeDimension;
+        if (relativeDimension > 1.0 - epsilon + Tolerance)
+        {
+            transformedDimension = 1.0;
+        }
+        else if (relativeDimension < epsilon - Tolerance)
+        {
+            transformedDimension = 0.0;
+        }
+
+        volume += transformedDimension * MinimumCrossSection(item, axis);
+    }
+
+    return volume / (static_cast<double>(mContainer.Volume) / length);
+}
+
+bool GeometricBounds::FloorAreaViolated() const
+{
+    const auto floorArea = static_cast<double>(mContainer.Dx) * mContainer.Dy;
+
+    // Two smallest heights to determine the smallest height of all other items.
+    auto smallestHeight = std::numeric_limits<int>::max();
+    auto secondSmallestHeight = std::numeric_limits<int>::max();
+    for (const auto& item: mItems)
+    {
+        if (item.Dz < smallestHeight)
+        {
+            secondSmallestHeight = smallestHeight;
+            smallestHeight = item.Dz;
+        }
+        else if (item.Dz < secondSmallestHeight)
+        {
+            secondSmallestHeight = item.Dz;
+        }
+    }
+
+    // Items that are too high to share a vertical column with any other item have a disjoint footprint, all other
+    // items are placed in the remaining floor area.
+    std::vector<bool> isExclusive(mItems.size(), false);
+    double exclusiveArea = 0.0;
+    double remainingVolume = 0.0;
+    for (size_t i = 0; i < mItems.size(); ++i)
+    {
+        const auto& item = mItems[i];
+        const auto smallestOtherHeight = item.Dz == smallestHeight ? secondSmallestHeight : smallestHeight;
+        if (mItems.size() > 1 && item.Dz + smallestOtherHeight > mContainer.Dz)
+        {
+            isExclusive[i] = true;
+            exclusiveArea += item.Area;
+        }
+        else
+        {
+            remainingVolume += item.Volume;
+        }
+    }
+
+    if (exclusiveArea + remainingVolume / mContainer.Dz > floorArea + Tolerance)
+    {
+        return true;
+    }
+
+    if (!mEnableSupport)
+    {
+        return false;
+    }
+
+    // Items that cannot be supported by any other item must be placed on the floor. Non-fragile items can only be
+    // supported by non-fragile items if fragility is enabled.
+    double floorItemsArea = exclusiveArea;
+    for (size_t i = 0; i < mItems.size(); ++i)
+    {
+        const auto& item = mItems[i];
+        if (isExclusive[i])
+        {
+            continue;
+        }
+
+        const auto needsNonFragileSupport = mEnableFragility && item.Fragility == Fragility::None;
+
+        bool canBeSupported = false;
+        for (size_t j = 0; j < mItems.size() && !canBeSupported; ++j)
+        {
+            if (i == j || (needsNonFragileSupport && mItems[j].Fragility == Fragility::Fragile))
+            {
+                continue;
+            }
+
+            canBeSupported = item.Dz + mItems[j].Dz <= mContainer.Dz;
+        }
+
+        if (!canBeSupported)
+        {
+            floorItemsArea += item.Area;
+        }
+    }
+
+    return floorItemsArea > floorArea + Tolerance;
+}
+
+bool GeometricBounds::CumulativeProfileViolated() const
+{
+    for (const auto& [axis, firstOther, secondOther]: AxisTriples)
+    {
+        const auto crossSection =
+            static_cast<double>(mContainer.Dimension(firstOther)) * mContainer.Dimension(secondOther);
+
+        int64_t sumLength = 0;
+        for (const auto& item: mItems)
+        {
+            if (2.0 * MinimumCrossSection(item, axis) > crossSection)
+            {
+                sumLength += item.MinimumRotatableDimension(axis);
+            }
+        }
+
+        if (sumLength > mContainer.Dimension(axis))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+double GeometricBounds::MinimumCrossSection(const Cuboid& item, Axis axis)
+{
+    switch (axis)
+    {
+        case Axis::X:
+            return static_cast<double>(item.MinimumRotatableDimension(Axis::Y)) * item.Dz;
+        case Axis::Y:
+            return static_cast<double>(item.MinimumRotatableDimension(Axis::X)) * item.Dz;
+        case Axis::Z:
+            return item.Area;
+        default:
+            throw std::runtime_error("Invalid axis.");
+    }
+}
+
+}
+}
@@ -1,12 +1,22 @@
 #include "Algorithms/SingleContainer/OPP_CP_3D.h"
 
+#include "ortools/util/time_limit.h"
+
 #include <algorithm>
+#include <array>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <map>
+#include <numeric>
 #include <ostream>
 #include <ranges>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace ContainerLoading
 {
@@ -14,8 +24,96 @@ using namespace Model;
 
 namespace Algorithms
 {
+/// Patterns other than unit discretization consist of sums of item dimensions (and the container dimension minus such
+/// sums), which are multiples of the GCD -> the scaled model has the same placements.
+std::array<int, 3> ContainerLoadingCP::DetermineScales(const CPSolverParams& params,
+                                                       const Container& container,
+                                                       const std::vector<Cuboid>& items,
+                                                       const std::vector<LoadingFlag>& loadingMasks)
+{
+    std::array<int, 3> scales = {1, 1, 1};
+    if (!params.EnableDimensionScaling)
+    {
+        return scales;
+    }
+
+    std::array<bool, 3> isScalable = {true, true, true};
+    for (const auto mask: loadingMasks)
+    {
+        const auto [patternTypeX, patternTypeY, patternTypeZ] =
+            PlacementPointGenerator::SelectMinimalFeasiblePatternType(mask);
+        isScalable[AxisX] = isScalable[AxisX] && patternTypeX != PlacementPattern::UnitDiscretization;
+        isScalable[AxisY] = isScalable[AxisY] && patternTypeY != PlacementPattern::UnitDiscretization;
+        isScalable[AxisZ] = isScalable[AxisZ] && patternTypeZ != PlacementPattern::UnitDiscretization;
+    }
+
+    std::array<int, 3> divisors = {container.Dx, container.Dy, container.Dz};
+    bool hasRotatableItems = false;
+    for (const auto& item: items)
+    {
+        divisors[AxisX] = std::gcd(divisors[AxisX], item.Dx);
+        divisors[AxisY] = std::gcd(divisors[AxisY], item.Dy);
+        divisors[AxisZ] = std::gcd(divisors[AxisZ], item.Dz);
+        hasRotatableItems = hasRotatableItems || item.EnableHorizontalRotation;
+    }
+
+    // Rotated items are placed with Dy along x and Dx along y -> same unit on both axes.
+    if (hasRotatableItems)
+    {
+        const auto isScalableXY = isScalable[AxisX] && isScalable[AxisY];
+        isScalable[AxisX] = isScalableXY;
+        isScalable[AxisY] = isScalableXY;
+        divisors[AxisX] = std::gcd(divisors[AxisX], divisors[AxisY]);
+        divisors[AxisY] = divisors[AxisX];
+    }
+
+    for (size_t d = 0; d < scales.size(); ++d)
+    {
+        if (isScalable[d] && divisors[d] > 1)
+        {
+            scales[d] = divisors[d];
+        }
+    }
+
+    return scales;
+}
+
+Container ContainerLoadingCP::ScaleContainer(const Container& container, const std::array<int, 3>& scales)
+{
+    auto scaledContainer = container;
+    scaledContainer.Dx /= scales[AxisX];
+    scaledContainer.Dy /= scales[AxisY];
+    scaledContainer.Dz /= scales[AxisZ];
+    scaledContainer.Area = static_cast<double>(scaledContainer.Dx) * scaledContainer.Dy;
+    scaledContainer.Volume = scaledContainer.Area * scaledContainer.Dz;
+
+    return scaledContainer;
+}
+
+std::vector<Cuboid> ContainerLoadingCP::ScaleItems(const std::vector<Cuboid>& items, const std::array<int, 3>& scales)
+{
+    auto scaledItems = items;
+    for (auto& item: scaledItems)
+    {
+        item.Dx /= scales[AxisX];
+        item.Dy /= scales[AxisY];
+        item.Dz /= scales[AxisZ];
+        item.Area = static_cast<double>(item.Dx) * item.Dy;
+        item.Volume = item.Area * item.Dz;
+    }
+
+    return scaledItems;
+}
+
 void ContainerLoadingCP::BuildModel()
 {
+    if (mParams.EnableSymmetryBreaking)
+    {
+        DetermineIdenticalItems();
+    }
+
+    DetermineMinimumDimensions();
+
     CreateVariables();
 
     AddConstraints();
@@ -25,19 +123,84 @@ void ContainerLoadingCP::BuildModel()
 
 LoadingStatus ContainerLoadingCP::Solve()
 {
-    BuildModel();
+    if (mLoadingMasks.size() != 1)
+    {
+        throw std::runtime_error("Loading mask must be given for CP model with several masks.");
+    }
+
+    return Solve(mLoadingMasks.front(), mMaxRuntime);
+}
+
+LoadingStatus ContainerLoadingCP::Solve(LoadingFlag loadingMask, double maxRuntime)
+{
+    return Solve(loadingMask, maxRuntime, mParams.Threads, nullptr);
+}
+
+LoadingStatus
+    ContainerLoadingCP::Solve(LoadingFlag loadingMask, double maxRuntime, int threads, std::atomic<bool>* stopFlag)
+{
+    const auto maskIt = std::ranges::find(mLoadingMasks, loadingMask);
+    if (maskIt == std::end(mLoadingMasks))
+    {
+        throw std::runtime_error("Loading mask is not part of the CP model.");
+    }
+
+    if (!mIsBuilt)
+    {
+        BuildModel();
+
+        AddSolutionHint();
+
+        mProtoModel = mModelCP.Build();
+        mIsBuilt = true;
+    }
+
+    if (mStopToken != nullptr)
+    {
+        maxRuntime = mStopToken->LimitRuntime(maxRuntime);
+    }
 
     operations_research::sat::SatParameters parameters;
-    SetParameters(parameters);
+    SetParameters(parameters, maxRuntime, threads);
 
     operations_research::sat::Model model = operations_research::sat::Model();
     model.Add(operations_research::sat::NewSatParameters(parameters));
 
-    operations_research::sat::CpModelProto protoModel = mModelCP.Build();
-    ////auto validationResponse = operations_research::sat::ValidateCpModel(protoModel);
+    // CP-SAT supports a second external flag -> stop of a race and stop of the run.
+    auto* timeLimit = model.GetOrCreate<operations_research::TimeLimit>();
+    if (stopFlag != nullptr)
+    {
+        timeLimit->RegisterExternalBooleanAsLimit(stopFlag);
+        if (mStopToken != nullptr)
+        {
+            timeLimit->RegisterSecondaryExternalBooleanAsLimit(mStopToken->StopFlag());
+        }
+    }
+    else if (mStopToken != nullptr)
+    {
+        timeLimit->RegisterExternalBooleanAsLimit(mStopToken->StopFlag());
+    }
+
+    ////auto validationResponse = operations_research::sat::ValidateCpModel(mProtoModel);
     ////LOG(INFO) << validationResponse;
 
-    mResponse = operations_research::sat::SolveCpModel(protoModel, &model);
+    const auto assumptions =
+        DetermineAssumptions(static_cast<size_t>(std::distance(std::begin(mLoadingMasks), maskIt)));
+    if (assumptions.empty())
+    {
+        mResponse = operations_research::sat::SolveCpModel(mProtoModel, &model);
+    }
+    else
+    {
+        // The built model is kept for the other masks.
+        auto protoModel = mProtoModel;
+        for (const auto literal: assumptions)
+        {
+            protoModel.add_assumptions(literal);
+        }
+
+        mResponse = operations_research::sat::SolveCpModel(protoModel, &model);
+    }
 
     ////LOG(INFO) << operations_research::sat::CpSolverResponseStats(mResponse);
 
@@ -57,6 +220,204 @@ LoadingStatus ContainerLoadingCP::Solve()
     }
 }
 
+std::vector<int> ContainerLoadingCP::DetermineAssumptions(size_t maskIndex) const
+{
+    const auto loadingMask = mLoadingMasks[maskIndex];
+
+    std::vector<int> assumptions;
+    auto addAssumption = [&assumptions](const EnforcementLiteral& literal, bool isEnforced)
+    {
+        if (literal.IsGuarded)
+        {
+            assumptions.push_back(isEnforced ? literal.Literal.index() : literal.Literal.Not().index());
+        }
+    };
+
+    const auto isLifo = IsSet(loadingMask, LoadingFlag::Lifo);
+    const auto isSequence = IsSet(loadingMask, LoadingFlag::Sequence);
+
+    addAssumption(mFragilityLiteral, IsSet(loadingMask, LoadingFlag::Fragility));
+    addAssumption(mSupportLiteral, IsSet(loadingMask, LoadingFlag::Support));
+    addAssumption(mLifoSequenceLiteral, isLifo && isSequence);
+    addAssumption(mLifoNoSequenceLiteral, isLifo && !isSequence);
+
+    for (size_t t = 0; t < mPatternLiterals.size(); ++t)
+    {
+        addAssumption(mPatternLiterals[t], t == mMaskPatternTypes[maskIndex]);
+    }
+
+    for (const auto& literal: mCustomerLiterals)
+    {
+        assumptions.push_back(literal.index());
+    }
+
+    return assumptions;
+}
+
+ORBoolVars1D ContainerLoadingCP::CustomerLiterals(size_t i, size_t j) const
+{
+    if (!mEnableCustomerAssumptions)
+    {
+        return {};
+    }
+
+    const auto customerI = mItems[i].GroupId;
+    const auto customerJ = mItems[j].GroupId;
+    if (customerI == customerJ)
+    {
+        return {mCustomerLiterals[customerI]};
+    }
+
+    return {mCustomerLiterals[customerI], mCustomerLiterals[customerJ]};
+}
+
+bool ContainerLoadingCP::IsSetInAnyMask(const std::vector<LoadingFlag>& masks, LoadingFlag flag)
+{
+    return std::ranges::any_of(masks, [flag](LoadingFlag mask) { return IsSet(mask, flag); });
+}
+
+bool ContainerLoadingCP::IsLifoInAnyMask(const std::vector<LoadingFlag>& masks, bool fixedSequence)
+{
+    return std::ranges::any_of(masks,
+                               [fixedSequence](LoadingFlag mask)
+                               {
+                                   return IsSet(mask, LoadingFlag::Lifo)
+                                          && IsSet(mask, LoadingFlag::Sequence) == fixedSequence;
+                               });
+}
+
+/// Positions, orientations and relative directions of hinted items. Relative directions are only hinted between two
+/// hinted items.
+void ContainerLoadingCP::AddSolutionHint()
+{
+    if (mSolutionHint.empty())
+    {
+        return;
+    }
+
+    if (mSolutionHint.size() != mItems.size())
+    {
+        throw std::runtime_error("Solution hint does not match number of items.");
+    }
+
+    // Positions of other packings that are not multiples of the scales cannot be hinted.
+    for (auto& hint: mSolutionHint)
+    {
+        if (!hint.has_value())
+        {
+            continue;
+        }
+
+        if (hint->X % mScales[AxisX] != 0 || hint->Y % mScales[AxisY] != 0 || hint->Z % mScales[AxisZ] != 0)
+        {
+            hint.reset();
+            continue;
+        }
+
+        hint->X /= mScales[AxisX];
+        hint->Y /= mScales[AxisY];
+        hint->Z /= mScales[AxisZ];
+    }
+
+    SortSolutionHintOfIdenticalItems();
+
+    // Variables may be shared, e.g. fixed lengths as constants or both directions of a pair, but CP-SAT rejects a hint
+    // with duplicate variables -> each variable is hinted once.
+    std::unordered_set<int> hintedVariables;
+    auto addHint = [this, &hintedVariables](const auto& variable, auto value)
+    {
+        const auto index = variable.index() >= 0 ? variable.index() : -variable.index() - 1;
+        if (hintedVariables.insert(index).second)
+        {
+            mModelCP.AddHint(variable, value);
+        }
+    };
+
+    const auto numberOfItems = mItems.size();
+    std::vector<std::array<int, 6>> bounds(numberOfItems);
+    for (size_t i = 0; i < numberOfItems; ++i)
+    {
+        if (!mSolutionHint[i].has_value())
+        {
+            continue;
+        }
+
+        const auto& hint = *mSolutionHint[i];
+        const auto& item = mItems[i];
+        const auto rotated = hint.Rotated && item.EnableHorizontalRotation;
+        const auto length = rotated ? item.Dy : item.Dx;
+        const auto width = rotated ? item.Dx : item.Dy;
+
+        addHint(mStartPositionsX[i], hint.X);
+        addHint(mEndPositionsX[i], hint.X + length);
+        addHint(mStartPositionsY[i], hint.Y);
+        addHint(mEndPositionsY[i], hint.Y + width);
+        addHint(mStartPositionsZ[i], hint.Z);
+        addHint(mEndPositionsZ[i], hint.Z + item.Dz);
+
+        addHint(mLengths[i], length);
+        addHint(mWidths[i], width);
+
+        addHint(mOrientation[i][NoRotation], !rotated);
+        addHint(mOrientation[i][RotationZ], rotated);
+
+        addHint(mPlacedOnFloor[i], hint.Z == 0);
+
+        bounds[i] = {hint.X, hint.X + length, hint.Y, hint.Y + width, hint.Z, hint.Z + item.Dz};
+    }
+
+    for (size_t i = 0; i < numberOfItems; ++i)
+    {
+        for (size_t j = 0; j < numberOfItems; ++j)
+        {
+            if (i == j || !mSolutionHint[i].has_value() || !mSolutionHint[j].has_value())
+            {
+                continue;
+            }
+
+            for (const auto& dimension: mDimensions)
+            {
+                const auto axis = static_cast<size_t>(dimension.Type);
+                const auto startI = bounds[i][2 * axis];
+                const auto endI = bounds[i][2 * axis + 1];
+                const auto startJ = bounds[j][2 * axis];
+                const auto endJ = bounds[j][2 * axis + 1];
+
+                addHint(mRelativeDirections[i][j][dimension.FirstDirection], endJ <= startI);
+                addHint(mRelativeDirections[i][j][dimension.SecondDirection], endI <= startJ);
+            }
+        }
+    }
+}
+
+/// Identical items are interchangeable -> their hinted placements are assigned in the order of the symmetry breaking
+/// constraints.
+void ContainerLoadingCP::SortSolutionHintOfIdenticalItems()
+{
+    for (const auto& identicalItems: mIdenticalItems)
+    {
+        std::vector<size_t> hintedItems;
+        std::vector<PlacementHint> hints;
+        for (const auto i: identicalItems)
+        {
+            if (mSolutionHint[i].has_value())
+            {
+                hintedItems.push_back(i);
+                hints.push_back(*mSolutionHint[i]);
+            }
+        }
+
+        std::ranges::sort(hints,
+                          [](const PlacementHint& lhs, const PlacementHint& rhs)
+                          { return std::tie(lhs.X, lhs.Y, lhs.Z) < std::tie(rhs.X, rhs.Y, rhs.Z); });
+
+        for (size_t k = 0; k < hintedItems.size(); ++k)
+        {
+            mSolutionHint[hintedItems[k]] = hints[k];
+        }
+    }
+}
+
 void ContainerLoadingCP::WriteProtoModel(const operations_research::sat::CpModelProto& protoModel) const
 {
     std::string protoModelString = protoModel.DebugString();
@@ -65,12 +426,14 @@ void ContainerLoadingCP::WriteProtoModel(const operations_research::sat::CpModel
     file.close();
 }
 
-void ContainerLoadingCP::SetParameters(operations_research::sat::SatParameters& parameters) const
+void ContainerLoadingCP::SetParameters(operations_research::sat::SatParameters& parameters,
+                                       double maxRuntime,
+                                       int threads) const
 {
-    parameters.set_num_search_workers(mParams.Threads);
+    parameters.set_num_search_workers(threads);
     parameters.set_log_search_progress(mParams.LogFlag);
     ////parameters.set_search_branching(parameters.PORTFOLIO_SEARCH);
-    parameters.set_max_time_in_seconds(mMaxRuntime);
+    parameters.set_max_time_in_seconds(maxRuntime);
     // Setting seed value is without effect for parallel mode
     // https://github.com/google/or-tools/issues/2793
     ////parameters.set_random_seed(mParams.Seed);
@@ -150,10 +513,29 @@ void ContainerLoadingCP::ExtractPacking(std::vector<Cuboid>& items) const
 
         item.Rotated = (Rotation)operations_research::sat::SolutionBooleanValue(mResponse, mOrientation[i][RotationZ]);
 
-        item.X = operations_research::sat::SolutionIntegerValue(mResponse, mStartPositionsX[i]);
-        item.Y = operations_research::sat::SolutionIntegerValue(mResponse, mStartPositionsY[i]);
-        item.Z = operations_research::sat::SolutionIntegerValue(mResponse, mStartPositionsZ[i]);
+        item.X = mScales[AxisX] * operations_research::sat::SolutionIntegerValue(mResponse, mStartPositionsX[i]);
+        item.Y = mScales[AxisY] * operations_research::sat::SolutionIntegerValue(mResponse, mStartPositionsY[i]);
+        item.Z = mScales[AxisZ] * operations_research::sat::SolutionIntegerValue(mResponse, mStartPositionsZ[i]);
+    }
+}
+
+std::vector<size_t> ContainerLoadingCP::ExtractInfeasibleCustomers() const
+{
+    std::vector<size_t> customers;
+    for (const auto literal: mResponse.sufficient_assumptions_for_infeasibility())
+    {
+        for (size_t g = 0; g < mCustomerLiterals.size(); ++g)
+        {
+            if (mCustomerLiterals[g].index() == literal)
+            {
+                customers.push_back(g);
+            }
+        }
     }
+
+    std::ranges::sort(customers);
+
+    return customers;
 }
 
 std::vector<int> ContainerLoadingCP::ExtractSequence() const
@@ -181,21 +563,21 @@ void ContainerLoadingCP::CreateVariables()
 {
     size_t numberOfItems = mItems.size();
 
-    std::vector<Cuboid> itemCopy;
-    itemCopy.reserve(mItems.size());
-    for (const auto& item: mItems)
+    CreateEnforcementLiterals();
+
+    if (mEnableCustomerAssumptions)
     {
-        itemCopy.push_back(item);
+        mCustomerLiterals.reserve(mNumberCustomers);
+        for (size_t g = 0; g < mNumberCustomers; ++g)
+        {
+            mCustomerLiterals.emplace_back(mModelCP.NewBoolVar());
+        }
     }
 
-    auto placementPointsPerType = PlacementPointGenerator::GeneratePlacementPatterns(
-        mContainer, itemCopy, mPlacementPatternTypeX, mPlacementPatternTypeY, mPlacementPatternTypeZ);
+    CreateStartPositions(mItems);
 
-    mStartPositionsX.reserve(numberOfItems);
     mEndPositionsX.reserve(numberOfItems);
-    mStartPositionsY.reserve(numberOfItems);
     mEndPositionsY.reserve(numberOfItems);
-    mStartPositionsZ.reserve(numberOfItems);
     mEndPositionsZ.reserve(numberOfItems);
 
     for (size_t i = 0; i < numberOfItems; i++)
@@ -204,16 +586,8 @@ void ContainerLoadingCP::CreateVariables()
         int minLength = item.EnableHorizontalRotation ? std::min(item.Dx, item.Dy) : item.Dx;
         int minWidth = item.EnableHorizontalRotation ? std::min(item.Dx, item.Dy) : item.Dy;
 
-        mStartPositionsX.emplace_back(
-            mModelCP.NewIntVar(operations_research::Domain::FromValues(placementPointsPerType[item].X)));
         mEndPositionsX.emplace_back(mModelCP.NewIntVar({minLength, mContainer.Dx}));
-
-        mStartPositionsY.emplace_back(
-            mModelCP.NewIntVar(operations_research::Domain::FromValues(placementPointsPerType[item].Y)));
         mEndPositionsY.emplace_back(mModelCP.NewIntVar({minWidth, mContainer.Dy}));
-
-        mStartPositionsZ.emplace_back(
-            mModelCP.NewIntVar(operations_research::Domain::FromValues(placementPointsPerType[item].Z)));
         mEndPositionsZ.emplace_back(mModelCP.NewIntVar({item.Dz, mContainer.Dz}));
     }
 
@@ -295,13 +669,21 @@ void ContainerLoadingCP::CreateVariables()
             mRelativeDirections.reserve(mDimensions.size());
             for (size_t d = 0; d < mDimensions.size(); ++d)
             {
+                // Items that overlap along this dimension in every placement are never next to each other.
+                if (i == j || !CanBeSeparated(i, j, mDimensions[d].Type))
+                {
+                    mRelativeDirections[i][j].emplace_back(mModelCP.FalseVar());
+                    mRelativeDirections[i][j].emplace_back(mModelCP.FalseVar());
+                    continue;
+                }
+
                 mRelativeDirections[i][j].emplace_back(mModelCP.NewBoolVar());
                 mRelativeDirections[i][j].emplace_back(mModelCP.NewBoolVar());
             }
 
             if (mEnableFragility || mEnableSupport)
             {
-                mSupportXY[i].emplace_back(mModelCP.NewBoolVar());
+                mSupportXY[i].emplace_back(CanSupport(i, j) ? mModelCP.NewBoolVar() : mModelCP.FalseVar());
             }
         }
     }
@@ -326,16 +708,31 @@ void ContainerLoadingCP::CreateVariables()
             const Cuboid& itemJ = mItems[j];
             int maxIntersection = std::max(itemI.Dx * itemI.Dy, itemJ.Dx * itemJ.Dy);
 
+            // The xy-intersection of items that cannot be stacked is not used.
+            if (!CanBeStacked(i, j))
+            {
+                mItemsOverlapsXY[i].emplace_back(mModelCP.FalseVar());
+                if (mEnableSupport)
+                {
+                    mOverlapAreasXY[i].emplace_back(mModelCP.NewConstant(0));
+                }
+
+                continue;
+            }
+
             mItemsOverlapsXY[i].emplace_back(mModelCP.NewBoolVar());
 
             if (mEnableSupport)
             {
-                mOverlapAreasXY[i].emplace_back(mModelCP.NewIntVar({0, maxIntersection}));
+                // The overlap area is only used for supports.
+                mOverlapAreasXY[i].emplace_back(CanSupport(i, j) || CanSupport(j, i)
+                                                    ? mModelCP.NewIntVar({0, maxIntersection})
+                                                    : mModelCP.NewConstant(0));
             }
         }
     }
 
-    if (mEnableLifo && !mFixedSequence)
+    if (mEnableLifoNoSequence)
     {
         mCustomerPosition.reserve(mNumberCustomers);
         for (size_t i = 0; i < mNumberCustomers; ++i)
@@ -358,6 +755,167 @@ void ContainerLoadingCP::CreateVariables()
     mMaxLength = mModelCP.NewIntVar({0, mContainer.Dx});
 }
 
+void ContainerLoadingCP::CreateEnforcementLiterals()
+{
+    auto countMasks = [this](const std::function<bool(LoadingFlag)>& isEnforced)
+    { return static_cast<size_t>(std::ranges::count_if(mLoadingMasks, isEnforced)); };
+
+    mFragilityLiteral =
+        CreateEnforcementLiteral(countMasks([](LoadingFlag mask) { return IsSet(mask, LoadingFlag::Fragility); }));
+    mSupportLiteral =
+        CreateEnforcementLiteral(countMasks([](LoadingFlag mask) { return IsSet(mask, LoadingFlag::Support); }));
+    mLifoSequenceLiteral = CreateEnforcementLiteral(countMasks(
+        [](LoadingFlag mask) { return IsSet(mask, LoadingFlag::Lifo) && IsSet(mask, LoadingFlag::Sequence); }));
+    mLifoNoSequenceLiteral = CreateEnforcementLiteral(countMasks(
+        [](LoadingFlag mask) { return IsSet(mask, LoadingFlag::Lifo) && !IsSet(mask, LoadingFlag::Sequence); }));
+
+    for (const auto mask: mLoadingMasks)
+    {
+        const auto patternTypes = PlacementPointGenerator::SelectMinimalFeasiblePatternType(mask);
+        auto it = std::ranges::find(mPatternTypes, patternTypes);
+        if (it == std::end(mPatternTypes))
+        {
+            mPatternTypes.push_back(patternTypes);
+            it = std::end(mPatternTypes) - 1;
+        }
+
+        mMaskPatternTypes.push_back(static_cast<size_t>(std::distance(std::begin(mPatternTypes), it)));
+    }
+
+    for (size_t t = 0; t < mPatternTypes.size(); ++t)
+    {
+        mPatternLiterals.push_back(CreateEnforcementLiteral(
+            static_cast<size_t>(std::ranges::count(mMaskPatternTypes, t))));
+    }
+}
+
+ContainerLoadingCP::EnforcementLiteral ContainerLoadingCP::CreateEnforcementLiteral(size_t numberEnforcingMasks)
+{
+    if (numberEnforcingMasks == 0)
+    {
+        return EnforcementLiteral{mModelCP.FalseVar(), false};
+    }
+
+    if (numberEnforcingMasks == mLoadingMasks.size())
+    {
+        return EnforcementLiteral{mModelCP.TrueVar(), false};
+    }
+
+    return EnforcementLiteral{mModelCP.NewBoolVar(), true};
+}
+
+/// Start positions are restricted to the placement patterns of the mask. The domain of each variable is the union of
+/// the patterns of all masks, the pattern of each mask is enforced by its pattern literal.
+void ContainerLoadingCP::CreateStartPositions(const std::vector<Cuboid>& items)
+{
+    // Patterns of one type and axis are generated once, even if several masks use them.
+    std::vector<std::tuple<PlacementPattern, Axis>> patternKeys;
+    for (const auto& [patternTypeX, patternTypeY, patternTypeZ]: mPatternTypes)
+    {
+        for (const auto& key: {std::make_tuple(patternTypeX, Axis::X),
+                               std::make_tuple(patternTypeY, Axis::Y),
+                               std::make_tuple(patternTypeZ, Axis::Z)})
+        {
+            if (std::ranges::find(patternKeys, key) == std::end(patternKeys))
+            {
+                patternKeys.push_back(key);
+            }
+        }
+    }
+
+    auto generatePatterns = [this, &items](PlacementPattern patternType, Axis axis)
+    {
+        if (mPlacementPatternCache != nullptr)
+        {
+            return mPlacementPatternCache->GeneratePlacementPatterns(mContainer, items, patternType, axis);
+        }
+
+        // Each concurrent generation needs its own copy, the generator takes the items by non-const reference.
+        auto itemCopy = items;
+        return PlacementPointGenerator::GeneratePlacementPatterns(mContainer, itemCopy, patternType, axis);
+    };
+
+    // Axes are independent, patterns of large item sets are generated concurrently.
+    const auto enableParallelGeneration = mParams.ParallelPatternItems > 0 && patternKeys.size() > 1
+                                          && items.size() >= static_cast<size_t>(mParams.ParallelPatternItems);
+
+    std::map<std::tuple<PlacementPattern, Axis>, std::vector<boost::dynamic_bitset<>>> patterns;
+    if (enableParallelGeneration)
+    {
+        std::vector<std::future<std::vector<boost::dynamic_bitset<>>>> generatedPatterns;
+        generatedPatterns.reserve(patternKeys.size());
+        for (const auto& [patternType, axis]: patternKeys)
+        {
+            generatedPatterns.push_back(std::async(std::launch::async, generatePatterns, patternType, axis));
+        }
+
+        for (size_t k = 0; k < patternKeys.size(); ++k)
+        {
+            patterns.emplace(patternKeys[k], generatedPatterns[k].get());
+        }
+    }
+    else
+    {
+        for (const auto& [patternType, axis]: patternKeys)
+        {
+            patterns.emplace(std::make_tuple(patternType, axis), generatePatterns(patternType, axis));
+        }
+    }
+
+    auto createStartPosition = [this, &patterns](size_t i, Axis axis)
+    {
+        std::vector<const boost::dynamic_bitset<>*> patternsPerType;
+        patternsPerType.reserve(mPatternTypes.size());
+        for (const auto& [patternTypeX, patternTypeY, patternTypeZ]: mPatternTypes)
+        {
+            const auto patternType = axis == Axis::X ? patternTypeX : axis == Axis::Y ? patternTypeY : patternTypeZ;
+            patternsPerType.push_back(&patterns.at(std::make_tuple(patternType, axis))[i]);
+        }
+
+        auto patternUnion = *patternsPerType.front();
+        for (const auto* pattern: patternsPerType)
+        {
+            if (pattern->size() > patternUnion.size())
+            {
+                patternUnion.resize(pattern->size());
+            }
+
+            auto resizedPattern = *pattern;
+            resizedPattern.resize(patternUnion.size());
+            patternUnion |= resizedPattern;
+        }
+
+        auto startPosition = mModelCP.NewIntVar(operations_research::Domain::FromValues(
+            PlacementPointGenerator::ConvertPlacementBitsetToVector(patternUnion)));
+
+        for (size_t t = 0; t < patternsPerType.size(); ++t)
+        {
+            if (!mPatternLiterals[t].IsGuarded || *patternsPerType[t] == patternUnion)
+            {
+                continue;
+            }
+
+            mModelCP
+                .AddLinearConstraint(startPosition,
+                                     operations_research::Domain::FromValues(
+                                         PlacementPointGenerator::ConvertPlacementBitsetToVector(*patternsPerType[t])))
+                .OnlyEnforceIf(mPatternLiterals[t].Literal);
+        }
+
+        return startPosition;
+    };
+
+    mStartPositionsX.reserve(items.size());
+    mStartPositionsY.reserve(items.size());
+    mStartPositionsZ.reserve(items.size());
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        mStartPositionsX.emplace_back(createStartPosition(i, Axis::X));
+        mStartPositionsY.emplace_back(createStartPosition(i, Axis::Y));
+        mStartPositionsZ.emplace_back(createStartPosition(i, Axis::Z));
+    }
+}
+
 std::tuple<ORIntVars1D, ORIntVars1D> ContainerLoadingCP::GetIntVars(DimensionType dimension) const
 {
     switch (dimension)
@@ -398,20 +956,162 @@ void ContainerLoadingCP::AddConstraints()
         CreateSupportArea();
     }
 
-    if (mEnableLifo)
+    if (mEnableLifoSequence)
+    {
+        CreateLifoSequence();
+    }
+
+    if (mEnableLifoNoSequence)
     {
-        if (mFixedSequence)
+        CreatePositioningConstraints();
+        CreateLifoNoSequence();
+    }
+
+    CreateSymmetryBreaking();
+}
+
+void ContainerLoadingCP::DetermineIdenticalItems()
+{
+    std::unordered_map<Cuboid, size_t, HomogeneityHash, HomogeneityHash> classIndices;
+    std::vector<std::vector<size_t>> classes;
+    for (size_t i = 0; i < mItems.size(); ++i)
+    {
+        const auto [it, isNew] = classIndices.try_emplace(mItems[i], classes.size());
+        if (isNew)
         {
-            CreateLifoSequence();
+            classes.push_back({i});
         }
-        else
+        // HomogeneityHash compares the rotated dimensions, the model uses the stored dimensions.
+        else if (mItems[classes[it->second].front()].Dx == mItems[i].Dx)
         {
-            CreatePositioningConstraints();
-            CreateLifoNoSequence();
+            classes[it->second].push_back(i);
+        }
+    }
+
+    for (auto& identicalItems: classes)
+    {
+        if (identicalItems.size() > 1)
+        {
+            mIdenticalItems.push_back(std::move(identicalItems));
         }
     }
 }
 
+/// Only orientations that fit into the container are considered, all orientations if none fits (infeasible anyway).
+void ContainerLoadingCP::DetermineMinimumDimensions()
+{
+    mMinimumDimensions.reserve(mItems.size());
+    for (const auto& item: mItems)
+    {
+        std::array<int, 3> minimumDimensions{};
+        std::array<int, 3> minimumFittingDimensions{};
+        bool fits = false;
+        for (size_t o = 0; o < mItemOrientations.size(); ++o)
+        {
+            if (mItemOrientations[o] == RotationZ && !item.EnableHorizontalRotation)
+            {
+                continue;
+            }
+
+            const auto [length, width, height] = item.DetermineDimensions(mItemOrientations[o]);
+            const std::array<int, 3> dimensions{length, width, height};
+            const auto isFirst = o == 0;
+            for (size_t d = 0; d < dimensions.size(); ++d)
+            {
+                minimumDimensions[d] = isFirst ? dimensions[d] : std::min(minimumDimensions[d], dimensions[d]);
+            }
+
+            if (length > mContainer.Dx || width > mContainer.Dy || height > mContainer.Dz)
+            {
+                continue;
+            }
+
+            for (size_t d = 0; d < dimensions.size(); ++d)
+            {
+                minimumFittingDimensions[d] =
+                    fits ? std::min(minimumFittingDimensions[d], dimensions[d]) : dimensions[d];
+            }
+
+            fits = true;
+        }
+
+        mMinimumDimensions.push_back(fits ? minimumFittingDimensions : minimumDimensions);
+    }
+}
+
+/// Items i and j can be placed next to each other along the dimension if their smallest extents fit into the container.
+bool ContainerLoadingCP::CanBeSeparated(size_t i, size_t j, DimensionType dimension) const
+{
+    return mMinimumDimensions[i][dimension] + mMinimumDimensions[j][dimension]
+           <= mContainer.Dimension(static_cast<Axis>(dimension));
+}
+
+/// Item j can directly support item i: both fit on top of each other and fragility does not forbid it in all masks.
+bool ContainerLoadingCP::CanSupport(size_t i, size_t j) const
+{
+    if (i == j || !CanBeSeparated(i, j, AxisZ))
+    {
+        return false;
+    }
+
+    return !mEnableFragility || mFragilityLiteral.IsGuarded || mItems[j].Fragility == Fragility::None
+           || mItems[i].Fragility == Fragility::Fragile;
+}
+
+bool ContainerLoadingCP::CanBeStacked(size_t i, size_t j) const
+{
+    return i != j && CanBeSeparated(i, j, AxisZ);
+}
+
+/// Identical items are placed in lexicographic order of (x, y, z) of their start positions. Each packing can be
+/// transformed into such a packing by swapping identical items -> only symmetric solutions are removed.
+void ContainerLoadingCP::CreateSymmetryBreaking()
+{
+    for (const auto& identicalItems: mIdenticalItems)
+    {
+        for (size_t k = 0; k + 1 < identicalItems.size(); ++k)
+        {
+            AddLexicographicOrder(identicalItems[k], identicalItems[k + 1]);
+        }
+    }
+}
+
+void ContainerLoadingCP::AddLexicographicOrder(size_t i, size_t j)
+{
+    // Items of the same customer -> one customer literal.
+    const auto customerLiterals = CustomerLiterals(i, i);
+
+    auto enforcementLiterals = customerLiterals;
+    auto enforce = [&enforcementLiterals](operations_research::sat::Constraint constraint)
+    { constraint.OnlyEnforceIf(enforcementLiterals); };
+
+    enforce(mModelCP.AddLessOrEqual(mStartPositionsX[i], mStartPositionsX[j]));
+
+    operations_research::sat::BoolVar isEqualX = mModelCP.NewBoolVar();
+    enforce(mModelCP.AddEquality(mStartPositionsX[i], mStartPositionsX[j]).OnlyEnforceIf(isEqualX));
+    enforce(mModelCP.AddLessThan(mStartPositionsX[i], mStartPositionsX[j]).OnlyEnforceIf(isEqualX.Not()));
+
+    enforcementLiterals.push_back(isEqualX);
+    enforce(mModelCP.AddLessOrEqual(mStartPositionsY[i], mStartPositionsY[j]));
+
+    operations_research::sat::BoolVar isEqualY = mModelCP.NewBoolVar();
+    enforce(mModelCP.AddEquality(mStartPositionsY[i], mStartPositionsY[j]).OnlyEnforceIf(isEqualY));
+    enforce(mModelCP.AddLessThan(mStartPositionsY[i], mStartPositionsY[j]).OnlyEnforceIf(isEqualY.Not()));
+
+    enforcementLiterals.push_back(isEqualY);
+    enforce(mModelCP.AddLessThan(mStartPositionsZ[i], mStartPositionsZ[j]));
+
+    // Item i starts at or before item j in x -> i cannot be in front of j (end_j <= start_i).
+    if (customerLiterals.empty())
+    {
+        mModelCP.FixVariable(mRelativeDirections[i][j][InFront], false);
+    }
+    else
+    {
+        mModelCP.AddImplication(customerLiterals.front(), mRelativeDirections[i][j][InFront].Not());
+    }
+}
+
 /// Relative directions of items. Necessary for non overlapping items.
 void ContainerLoadingCP::CreateNoOverlap()
 {
@@ -428,6 +1128,12 @@ void ContainerLoadingCP::CreateNoOverlap()
             for (size_t d = 0; d < mDimensions.size(); ++d)
             {
                 const Dimension& dimension = mDimensions[d];
+                if (!CanBeSeparated(i, j, dimension.Type))
+                {
+                    // Both literals are constant false, the items overlap along this dimension in every placement.
+                    continue;
+                }
+
                 const auto [startPosition, endPosition] = GetIntVars(dimension.Type);
 
                 mModelCP.AddLessOrEqual(endPosition[j], startPosition[i])
@@ -444,8 +1150,8 @@ void ContainerLoadingCP::CreateNoOverlap()
                                      mRelativeDirections[j][i][dimension.SecondDirection]);
             }
 
-            // No overlap constraints
-            mModelCP.AddAtLeastOne(mRelativeDirections[i][j]);
+            // No overlap constraints, items of customers not in the core may overlap.
+            mModelCP.AddAtLeastOne(mRelativeDirections[i][j]).OnlyEnforceIf(CustomerLiterals(i, j));
         }
     }
 }
@@ -474,6 +1180,12 @@ void ContainerLoadingCP::CreateItemOrientations()
 /// Fragility of items
 void ContainerLoadingCP::CreateFragility()
 {
+    // Without assumptions, the forbidden supports are constant false (CanSupport).
+    if (!mFragilityLiteral.IsGuarded)
+    {
+        return;
+    }
+
     size_t numberOfItems = mItems.size();
 
     // Variant 2 - fragile items can be stacked on fragile items.
@@ -485,10 +1197,10 @@ void ContainerLoadingCP::CreateFragility()
         {
             if (mItems[j].Fragility == Fragility::Fragile && mItems[i].Fragility == Fragility::None)
             {
-                if (i != j)
+                if (CanSupport(i, j))
                 {
                     // Item j cannot support item i, if j is fragile and i non fragile.
-                    mModelCP.FixVariable(mSupportXY[i][j], false);
+                    mModelCP.AddImplication(mFragilityLiteral.Literal, mSupportXY[i][j].Not());
                 }
             }
         }
@@ -504,13 +1216,8 @@ void ContainerLoadingCP::CreateSupportArea()
         int areaI = mItems[i].Dy * mItems[i].Dx;
         for (size_t j = 0; j < mItems.size(); ++j)
         {
-            if (i == j)
-            {
-                continue;
-            }
-
-            if (!mEnableFragility || mItems[j].Fragility == Fragility::None
-                || (mItems[j].Fragility == Fragility::Fragile && mItems[i].Fragility == Fragility::Fragile))
+            // E.g. fragile items cannot support non-fragile items if fragility is enforced in all masks.
+            if (CanSupport(i, j))
             {
                 int areaJ = mItems[j].Dy * mItems[j].Dx;
                 int minArea = std::min(areaI, areaJ);
@@ -534,9 +1241,17 @@ void ContainerLoadingCP::CreateSupportArea()
         operations_research::sat::IntVar supportedArea = mModelCP.NewIntVar({0, areaI});
         mModelCP.AddEquality(supportedArea, supportedAreaExpr).OnlyEnforceIf(mPlacedOnFloor[i].Not());
 
-        mModelCP
-            .AddGreaterOrEqual(supportedArea, static_cast<int>(std::ceil(mSupportArea * mItems[i].Dx * mItems[i].Dy)))
-            .OnlyEnforceIf(mPlacedOnFloor[i].Not());
+        auto enforcementLiterals = CustomerLiterals(i, i);
+        enforcementLiterals.push_back(mPlacedOnFloor[i].Not());
+        enforcementLiterals.push_back(mSupportLiteral.Literal);
+
+        // Required area in original units, rounded up to a multiple of the scaled unit area.
+        const auto unitArea = mScales[AxisX] * mScales[AxisY];
+        const auto requiredArea = static_cast<int>(
+            std::ceil(mSupportArea * (mItems[i].Dx * mScales[AxisX]) * (mItems[i].Dy * mScales[AxisY])));
+
+        mModelCP.AddGreaterOrEqual(supportedArea, (requiredArea + unitArea - 1) / unitArea)
+            .OnlyEnforceIf(enforcementLiterals);
     }
 }
 
@@ -549,6 +1264,11 @@ void ContainerLoadingCP::CreateXYIntersectionBool()
     {
         for (size_t j = i + 1; j < numberOfItems; ++j)
         {
+            if (!CanBeStacked(i, j))
+            {
+                continue;
+            }
+
             auto positionJ = j - i - 1;
 
             mModelCP.AddAtLeastOne({mItemsOverlapsXY[i][positionJ],
@@ -574,7 +1294,7 @@ void ContainerLoadingCP::CreateXYIntersectionArea()
     {
         for (size_t j = i + 1; j < numberOfItems; ++j)
         {
-            if (mItems[i].Dz + mItems[j].Dz <= mContainer.Dz)
+            if (CanSupport(i, j) || CanSupport(j, i))
             {
                 // Variant 2
                 auto positionJ = j - i - 1;
@@ -625,10 +1345,10 @@ void ContainerLoadingCP::CreateSupportItem()
 {
     for (size_t i = 0; i < mItems.size(); ++i)
     {
-        mModelCP.FixVariable(mSupportXY[i][i], false);
         for (size_t j = 0; j < mItems.size(); ++j)
         {
-            if (i == j)
+            // Item i is never placed directly on item j.
+            if (!CanBeStacked(i, j))
             {
                 continue;
             }
@@ -637,24 +1357,28 @@ void ContainerLoadingCP::CreateSupportItem()
             mModelCP.AddEquality(mEndPositionsZ[j], mStartPositionsZ[i]).OnlyEnforceIf(isVerticallyAdjacent);
             mModelCP.AddNotEqual(mEndPositionsZ[j], mStartPositionsZ[i]).OnlyEnforceIf(isVerticallyAdjacent.Not());
 
-            mModelCP.AddImplication(isVerticallyAdjacent.Not(), mSupportXY[i][j].Not());
+            const auto& overlapXY = i < j ? mItemsOverlapsXY[i][j - i - 1] : mItemsOverlapsXY[j][i - j - 1];
 
-            if (i < j)
-            {
-                auto position = j - i - 1;
+            // Items of customers not in the core neither restrict nor support other items.
+            const auto customerLiterals = CustomerLiterals(i, j);
 
-                mModelCP.AddAtLeastOne(
-                    {mSupportXY[i][j], isVerticallyAdjacent.Not(), mItemsOverlapsXY[i][position].Not()});
-                mModelCP.AddImplication(mItemsOverlapsXY[i][position].Not(), mSupportXY[i][j].Not());
-            }
-            else
+            // Support is constant false (fragility in all masks) -> item i must not touch item j from above.
+            if (!CanSupport(i, j))
             {
-                auto position = i - j - 1;
+                mModelCP.AddAtLeastOne({isVerticallyAdjacent.Not(), overlapXY.Not()}).OnlyEnforceIf(customerLiterals);
+                continue;
+            }
 
-                mModelCP.AddAtLeastOne(
-                    {mSupportXY[i][j], isVerticallyAdjacent.Not(), mItemsOverlapsXY[j][position].Not()});
-                mModelCP.AddImplication(mItemsOverlapsXY[j][position].Not(), mSupportXY[i][j].Not());
+            mModelCP.AddImplication(isVerticallyAdjacent.Not(), mSupportXY[i][j].Not());
+
+            if (mEnableCustomerAssumptions)
+            {
+                mModelCP.AddImplication(mSupportXY[i][j], mCustomerLiterals[mItems[j].GroupId]);
             }
+
+            mModelCP.AddAtLeastOne({mSupportXY[i][j], isVerticallyAdjacent.Not(), overlapXY.Not()})
+                .OnlyEnforceIf(customerLiterals);
+            mModelCP.AddImplication(overlapXY.Not(), mSupportXY[i][j].Not());
         }
     }
 }
@@ -674,8 +1398,13 @@ void ContainerLoadingCP::CreateLifoSequence()
                 // - item i is unloaded after item j (smaller group id) and
                 // - item i is not placed left or right of item j -> in way to rear end of container
 
+                auto enforcementLiterals = CustomerLiterals(i, j);
+                enforcementLiterals.push_back(mRelativeDirections[i][j][Left].Not());
+                enforcementLiterals.push_back(mRelativeDirections[i][j][Right].Not());
+                enforcementLiterals.push_back(mLifoSequenceLiteral.Literal);
+
                 mModelCP.AddAtLeastOne({mRelativeDirections[i][j][Behind], mRelativeDirections[i][j][Below]})
-                    .OnlyEnforceIf({mRelativeDirections[i][j][Left].Not(), mRelativeDirections[i][j][Right].Not()});
+                    .OnlyEnforceIf(enforcementLiterals);
             }
         }
     }
@@ -697,22 +1426,24 @@ void ContainerLoadingCP::CreateLifoNoSequence()
                 // - item i is unloaded after item j (customer i succeeds customer j) and
                 // - item i is not placed left or right of item j -> in way to rear end of container.
 
+                auto enforcementLiterals = CustomerLiterals(i, j);
+                enforcementLiterals.push_back(mRelativeDirections[i][j][Left].Not());
+                enforcementLiterals.push_back(mRelativeDirections[i][j][Right].Not());
+                enforcementLiterals.push_back(mLifoNoSequenceLiteral.Literal);
+
                 if (customerI < customerJ)
                 {
                     auto position = customerJ - customerI - 1;
-                    mModelCP.AddAtLeastOne({mRelativeDirections[i][j][Behind], mRelativeDirections[i][j][Below]})
-                        .OnlyEnforceIf({mRelativeDirections[i][j][Left].Not(),
-                                        mRelativeDirections[i][j][Right].Not(),
-                                        mSuccessionMatrix[customerI][position]});
+                    enforcementLiterals.push_back(mSuccessionMatrix[customerI][position]);
                 }
                 else
                 {
                     auto position = customerI - customerJ - 1;
-                    mModelCP.AddAtLeastOne({mRelativeDirections[i][j][Behind], mRelativeDirections[i][j][Below]})
-                        .OnlyEnforceIf({mRelativeDirections[i][j][Left].Not(),
-                                        mRelativeDirections[i][j][Right].Not(),
-                                        mSuccessionMatrix[customerJ][position].Not()});
+                    enforcementLiterals.push_back(mSuccessionMatrix[customerJ][position].Not());
                 }
+
+                mModelCP.AddAtLeastOne({mRelativeDirections[i][j][Behind], mRelativeDirections[i][j][Below]})
+                    .OnlyEnforceIf(enforcementLiterals);
             }
         }
     }
@@ -0,0 +1,330 @@
+#include "Algorithms/SingleContainer/OPP_EP_3D.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <tuple>
+
+namespace ContainerLoading
+{
+using namespace Model;
+
+namespace Algorithms
+{
+LoadingStatus ContainerLoadingEP::Solve()
+{
+    double totalVolume = 0.0;
+    for (const auto& item: mItems)
+    {
+        totalVolume += item.Volume;
+    }
+
+    if (totalVolume > mContainer.Volume)
+    {
+        return LoadingStatus::Infeasible;
+    }
+
+    for (const auto& order: DetermineItemOrders())
+    {
+        if (Pack(order))
+        {
+            return LoadingStatus::FeasOpt;
+        }
+    }
+
+    return LoadingStatus::Infeasible;
+}
+
+void ContainerLoadingEP::ExtractPacking(std::vector<Cuboid>& items) const
+{
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        auto& item = items[i];
+        const auto& placement = mPlacements[i];
+
+        item.Rotated = placement.Rotated ? Rotation::Yaw : Rotation::None;
+
+        item.X = placement.X;
+        item.Y = placement.Y;
+        item.Z = placement.Z;
+    }
+}
+
+std::vector<std::vector<size_t>> ContainerLoadingEP::DetermineItemOrders() const
+{
+    using Criterion = std::function<bool(const Cuboid&, const Cuboid&)>;
+
+    const std::vector<Criterion> criteria = {
+        [](const Cuboid& a, const Cuboid& b) { return a.Volume > b.Volume; },
+        [](const Cuboid& a, const Cuboid& b) { return std::tie(a.Area, a.Dz) > std::tie(b.Area, b.Dz); },
+        [](const Cuboid& a, const Cuboid& b) { return std::tie(a.Dz, a.Area) > std::tie(b.Dz, b.Area); },
+        [](const Cuboid& a, const Cuboid& b) { return std::max(a.Dx, a.Dy) > std::max(b.Dx, b.Dy); }};
+
+    std::vector<std::vector<size_t>> orders;
+    orders.reserve(criteria.size());
+    for (const auto& criterion: criteria)
+    {
+        std::vector<size_t> order(mItems.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i;
+        }
+
+        // With LIFO, the container is filled from the rear: items unloaded last (smallest group id) first.
+        std::ranges::stable_sort(order,
+                                 [this, &criterion](size_t i, size_t j)
+                                 {
+                                     const auto& itemI = mItems[i];
+                                     const auto& itemJ = mItems[j];
+                                     if (mEnableLifo && itemI.GroupId != itemJ.GroupId)
+                                     {
+                                         return itemI.GroupId < itemJ.GroupId;
+                                     }
+
+                                     return criterion(itemI, itemJ);
+                                 });
+
+        orders.push_back(std::move(order));
+    }
+
+    return orders;
+}
+
+bool ContainerLoadingEP::Pack(const std::vector<size_t>& order)
+{
+    mPlacements.assign(mItems.size(), Placement());
+    mPlacedItems.clear();
+    mExtremePoints = {ExtremePoint()};
+
+    for (const auto i: order)
+    {
+        const auto& item = mItems[i];
+        const auto enableRotation = item.EnableHorizontalRotation && item.Dx != item.Dy;
+
+        std::optional<Placement> bestPlacement;
+        for (const auto& point: mExtremePoints)
+        {
+            for (const auto rotated: {false, true})
+            {
+                if (rotated && !enableRotation)
+                {
+                    continue;
+                }
+
+                Placement placement{point.X,
+                                    point.Y,
+                                    point.Z,
+                                    rotated ? item.Dy : item.Dx,
+                                    rotated ? item.Dx : item.Dy,
+                                    item.Dz,
+                                    rotated};
+
+                if (bestPlacement.has_value()
+                    && std::tie(placement.X, placement.Z, placement.Y)
+                           >= std::tie(bestPlacement->X, bestPlacement->Z, bestPlacement->Y))
+                {
+                    continue;
+                }
+
+                if (IsFeasible(i, placement))
+                {
+                    bestPlacement = placement;
+                }
+            }
+        }
+
+        if (!bestPlacement.has_value())
+        {
+            return false;
+        }
+
+        mPlacements[i] = *bestPlacement;
+        mPlacedItems.push_back(i);
+        AddExtremePoints(*bestPlacement);
+    }
+
+    return true;
+}
+
+bool ContainerLoadingEP::IsFeasible(size_t item, const Placement& placement) const
+{
+    if (placement.X + placement.Dx > mContainer.Dx || placement.Y + placement.Dy > mContainer.Dy
+        || placement.Z + placement.Dz > mContainer.Dz)
+    {
+        return false;
+    }
+
+    const auto isFragile = mItems[item].Fragility == Fragility::Fragile;
+
+    int64_t supportedArea = 0;
+    for (const auto k: mPlacedItems)
+    {
+        const auto& other = mPlacements[k];
+
+        const auto overlapX =
+            std::min(placement.X + placement.Dx, other.X + other.Dx) - std::max(placement.X, other.X);
+        const auto overlapY =
+            std::min(placement.Y + placement.Dy, other.Y + other.Dy) - std::max(placement.Y, other.Y);
+        const auto overlapZ =
+            std::min(placement.Z + placement.Dz, other.Z + other.Dz) - std::max(placement.Z, other.Z);
+
+        if (overlapX > 0 && overlapY > 0 && overlapZ > 0)
+        {
+            return false;
+        }
+
+        // Items left or right of each other are not in the way when unloading.
+        if (mEnableLifo && overlapY > 0 && !SatisfiesLifo(item, placement, k))
+        {
+            return false;
+        }
+
+        if (overlapX <= 0 || overlapY <= 0)
+        {
+            continue;
+        }
+
+        const auto isOtherFragile = mItems[k].Fragility == Fragility::Fragile;
+        if (other.Z + other.Dz == placement.Z)
+        {
+            // Non-fragile items must not be placed onto fragile items.
+            if (mEnableFragility && isOtherFragile && !isFragile)
+            {
+                return false;
+            }
+
+            supportedArea += static_cast<int64_t>(overlapX) * overlapY;
+        }
+        else if (placement.Z + placement.Dz == other.Z)
+        {
+            if (mEnableFragility && isFragile && !isOtherFragile)
+            {
+                return false;
+            }
+        }
+    }
+
+    if (mEnableSupport && placement.Z > 0)
+    {
+        const auto requiredArea =
+            static_cast<int64_t>(std::ceil(mSupportArea * mItems[item].Dx * mItems[item].Dy));
+        if (supportedArea < requiredArea)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ContainerLoadingEP::SatisfiesLifo(size_t item, const Placement& placement, size_t other) const
+{
+    const auto groupItem = mItems[item].GroupId;
+    const auto groupOther = mItems[other].GroupId;
+    const auto& otherPlacement = mPlacements[other];
+
+    if (groupItem == groupOther)
+    {
+        return true;
+    }
+
+    // The item with the smaller group id is unloaded later and must be placed behind or below the other item.
+    const auto& rear = groupItem < groupOther ? placement : otherPlacement;
+    const auto& front = groupItem < groupOther ? otherPlacement : placement;
+
+    return rear.X + rear.Dx <= front.X || rear.Z + rear.Dz <= front.Z;
+}
+
+void ContainerLoadingEP::AddExtremePoints(const Placement& placement)
+{
+    // Extreme points covered by the new item cannot be used anymore.
+    std::erase_if(mExtremePoints,
+                  [&placement](const ExtremePoint& point)
+                  {
+                      return point.X >= placement.X && point.X < placement.X + placement.Dx
+                             && point.Y >= placement.Y && point.Y < placement.Y + placement.Dy
+                             && point.Z >= placement.Z && point.Z < placement.Z + placement.Dz;
+                  });
+
+    const ExtremePoint pointX{placement.X + placement.Dx, placement.Y, placement.Z};
+    const ExtremePoint pointY{placement.X, placement.Y + placement.Dy, placement.Z};
+    const ExtremePoint pointZ{placement.X, placement.Y, placement.Z + placement.Dz};
+
+    // Each corner and its projections along the two other axes.
+    const std::vector<ExtremePoint> newPoints = {pointX,
+                                                 Project(pointX, Axis::Y),
+                                                 Project(pointX, Axis::Z),
+                                                 pointY,
+                                                 Project(pointY, Axis::X),
+                                                 Project(pointY, Axis::Z),
+                                                 pointZ,
+                                                 Project(pointZ, Axis::X),
+                                                 Project(pointZ, Axis::Y)};
+
+    for (const auto& point: newPoints)
+    {
+        if (point.X < mContainer.Dx && point.Y < mContainer.Dy && point.Z < mContainer.Dz)
+        {
+            mExtremePoints.push_back(point);
+        }
+    }
+
+    std::ranges::sort(mExtremePoints);
+    const auto duplicates = std::ranges::unique(mExtremePoints);
+    mExtremePoints.erase(std::begin(duplicates), std::end(duplicates));
+}
+
+ContainerLoadingEP::ExtremePoint ContainerLoadingEP::Project(ExtremePoint point, Axis axis) const
+{
+    auto inRange = [](int value, int start, int length) { return value >= start && value < start + length; };
+
+    int projected = 0;
+    for (const auto k: mPlacedItems)
+    {
+        const auto& other = mPlacements[k];
+        switch (axis)
+        {
+            case Axis::X:
+                if (inRange(point.Y, other.Y, other.Dy) && inRange(point.Z, other.Z, other.Dz)
+                    && other.X + other.Dx <= point.X)
+                {
+                    projected = std::max(projected, other.X + other.Dx);
+                }
+                break;
+            case Axis::Y:
+                if (inRange(point.X, other.X, other.Dx) && inRange(point.Z, other.Z, other.Dz)
+                    && other.Y + other.Dy <= point.Y)
+                {
+                    projected = std::max(projected, other.Y + other.Dy);
+                }
+                break;
+            case Axis::Z:
+                if (inRange(point.X, other.X, other.Dx) && inRange(point.Y, other.Y, other.Dy)
+                    && other.Z + other.Dz <= point.Z)
+                {
+                    projected = std::max(projected, other.Z + other.Dz);
+                }
+                break;
+        }
+    }
+
+    switch (axis)
+    {
+        case Axis::X:
+            point.X = projected;
+            break;
+        case Axis::Y:
+            point.Y = projected;
+            break;
+        case Axis::Z:
+            point.Z = projected;
+            break;
+    }
+
+    return point;
+}
+
+}
+}
@@ -0,0 +1,95 @@
+#include "Helper/CPModelCache.h"
+
+#include <algorithm>
+
+namespace ContainerLoading
+{
+void CPModelCache::SetCapacity(size_t capacity)
+{
+    std::lock_guard lock(mMutex);
+
+    mCapacity = capacity;
+    while (mModels.size() > mCapacity)
+    {
+        mModels.pop_back();
+        mEvictions++;
+    }
+}
+
+size_t CPModelCache::Capacity() const
+{
+    std::lock_guard lock(mMutex);
+    return mCapacity;
+}
+
+std::shared_ptr<CachedCPModel>
+    CPModelCache::FindOrCreate(const Collections::IdVector& route,
+                               const Container& container,
+                               const std::vector<Cuboid>& items,
+                               const std::function<std::unique_ptr<ContainerLoadingCP>()>& createModel)
+{
+    std::lock_guard lock(mMutex);
+
+    const auto it = std::ranges::find_if(mModels,
+                                         [&route, &container, &items](const auto& model)
+                                         { return model->Route == route && Matches(*model, container, items); });
+    if (it != std::end(mModels))
+    {
+        mModels.splice(std::begin(mModels), mModels, it);
+        return mModels.front();
+    }
+
+    auto model = std::make_shared<CachedCPModel>();
+    model->Route = route;
+    model->ContainerDx = container.Dx;
+    model->ContainerDy = container.Dy;
+    model->ContainerDz = container.Dz;
+    model->Items = items;
+    model->Model = createModel();
+
+    if (mCapacity == 0)
+    {
+        return model;
+    }
+
+    mModels.push_front(model);
+    if (mModels.size() > mCapacity)
+    {
+        mModels.pop_back();
+        mEvictions++;
+    }
+
+    return model;
+}
+
+size_t CPModelCache::Size() const
+{
+    std::lock_guard lock(mMutex);
+    return mModels.size();
+}
+
+size_t CPModelCache::Evictions() const
+{
+    std::lock_guard lock(mMutex);
+    return mEvictions;
+}
+
+bool CPModelCache::Matches(const CachedCPModel& model, const Container& container, const std::vector<Cuboid>& items)
+{
+    if (model.ContainerDx != container.Dx || model.ContainerDy != container.Dy || model.ContainerDz != container.Dz
+        || model.Items.size() != items.size())
+    {
+        return false;
+    }
+
+    return std::ranges::equal(model.Items,
+                              items,
+                              [](const Cuboid& lhs, const Cuboid& rhs)
+                              {
+                                  return lhs.GroupId == rhs.GroupId && lhs.Dx == rhs.Dx && lhs.Dy == rhs.Dy
+                                         && lhs.Dz == rhs.Dz && lhs.Fragility == rhs.Fragility
+                                         && lhs.EnableHorizontalRotation == rhs.EnableHorizontalRotation;
+                              });
+}
+
+}
@@ -0,0 +1,193 @@
+#include "Helper/CombinationAntichain.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace ContainerLoading
+{
+namespace
+{
+void AddAtomic(size_t& counter, size_t value) { std::atomic_ref(counter).fetch_add(value, std::memory_order_relaxed); }
+}
+
+bool CombinationAntichain::Insert(const boost::dynamic_bitset<>& combination)
+{
+    if (combination.none())
+    {
+        return false;
+    }
+
+    std::unique_lock lock(mMutex);
+
+    size_t comparedCombinations = 0;
+    if (FindSubsetOf(combination, comparedCombinations))
+    {
+        mStatistics.RejectedDominated++;
+        return false;
+    }
+
+    const auto cardinality = combination.count();
+    RemoveSupersetsOf(combination, cardinality);
+
+    if (mCombinationsByCustomer.size() < combination.size())
+    {
+        mCombinationsByFirstCustomer.resize(combination.size());
+        mCombinationsByCustomer.resize(combination.size());
+    }
+
+    const auto id = mCombinations.size();
+    mCombinations.push_back(combination);
+    mCardinalities.push_back(cardinality);
+    mActive.push_back(true);
+
+    mCombinationsByFirstCustomer[combination.find_first()].push_back(id);
+    for (auto c = combination.find_first(); c != boost::dynamic_bitset<>::npos; c = combination.find_next(c))
+    {
+        mCombinationsByCustomer[c].push_back(id);
+    }
+
+    mSize++;
+    mStatistics.Inserted++;
+
+    return true;
+}
+
+bool CombinationAntichain::ContainsSubsetOf(const boost::dynamic_bitset<>& set) const
+{
+    std::shared_lock lock(mMutex);
+
+    size_t comparedCombinations = 0;
+    const auto found = FindSubsetOf(set, comparedCombinations);
+
+    AddAtomic(mStatistics.Queries, 1);
+    AddAtomic(mStatistics.ComparedCombinations, comparedCombinations);
+    if (found)
+    {
+        AddAtomic(mStatistics.Hits, 1);
+    }
+
+    return found;
+}
+
+size_t CombinationAntichain::Size() const
+{
+    std::shared_lock lock(mMutex);
+    return mSize;
+}
+
+CombinationAntichainStatistics CombinationAntichain::Statistics() const
+{
+    // Exclusive lock: no query updates the counters while they are copied.
+    std::unique_lock lock(mMutex);
+    return mStatistics;
+}
+
+bool CombinationAntichain::FindSubsetOf(const boost::dynamic_bitset<>& set, size_t& comparedCombinations) const
+{
+    const auto cardinality = set.count();
+    // Each combination is only registered under its smallest customer -> it is compared at most once.
+    for (auto c = set.find_first(); c != boost::dynamic_bitset<>::npos && c < mCombinationsByFirstCustomer.size();
+         c = set.find_next(c))
+    {
+        for (const auto id: mCombinationsByFirstCustomer[c])
+        {
+            if (!mActive[id] || mCardinalities[id] > cardinality)
+            {
+                continue;
+            }
+
+            comparedCombinations++;
+            if (mCombinations[id].is_subset_of(set))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void CombinationAntichain::RemoveSupersetsOf(const boost::dynamic_bitset<>& combination, size_t cardinality)
+{
+    // Every superset contains all customers of combination -> the shortest posting list is sufficient.
+    const std::vector<size_t>* candidates = nullptr;
+    for (auto c = combination.find_first(); c != boost::dynamic_bitset<>::npos; c = combination.find_next(c))
+    {
+        if (c >= mCombinationsByCustomer.size() || mCombinationsByCustomer[c].empty())
+        {
+            return;
+        }
+
+        if (candidates == nullptr || mCombinationsByCustomer[c].size() < candidates->size())
+        {
+            candidates = &mCombinationsByCustomer[c];
+        }
+    }
+
+    for (const auto id: *candidates)
+    {
+        if (!mActive[id] || mCardinalities[id] < cardinality)
+        {
+            continue;
+        }
+
+        if (combination.is_subset_of(mCombinations[id]))
+        {
+            mActive[id] = false;
+            mSize--;
+            mRemoved++;
+            mStatistics.RemovedSupersets++;
+        }
+    }
+
+    if (mRemoved > mSize)
+    {
+        Compact();
+    }
+}
+
+void CombinationAntichain::Compact()
+{
+    std::vector<boost::dynamic_bitset<>> combinations;
+    std::vector<size_t> cardinalities;
+    combinations.reserve(mSize);
+    cardinalities.reserve(mSize);
+
+    for (size_t id = 0; id < mCombinations.size(); ++id)
+    {
+        if (!mActive[id])
+        {
+            continue;
+        }
+
+        combinations.push_back(std::move(mCombinations[id]));
+        cardinalities.push_back(mCardinalities[id]);
+    }
+
+    mCombinations = std::move(combinations);
+    mCardinalities = std::move(cardinalities);
+    mActive.assign(mCombinations.size(), true);
+    mRemoved = 0;
+
+    for (auto& ids: mCombinationsByFirstCustomer)
+    {
+        ids.clear();
+    }
+
+    for (auto& ids: mCombinationsByCustomer)
+    {
+        ids.clear();
+    }
+
+    for (size_t id = 0; id < mCombinations.size(); ++id)
+    {
+        const auto& combination = mCombinations[id];
+        mCombinationsByFirstCustomer[combination.find_first()].push_back(id);
+        for (auto c = combination.find_first(); c != boost::dynamic_bitset<>::npos; c = combination.find_next(c))
+        {
+            mCombinationsByCustomer[c].push_back(id);
+        }
+    }
+}
+
+}
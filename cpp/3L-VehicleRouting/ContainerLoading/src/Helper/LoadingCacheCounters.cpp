@@ -0,0 +1,115 @@
+#include "Helper/LoadingCacheCounters.h"
+
+namespace ContainerLoading
+{
+void LoadingCacheCounters::AddLookup(LoadingFlag mask, CacheLookup lookup, bool hit, Clock::time_point start)
+{
+    auto& counter = mLookups[static_cast<size_t>(mask)][static_cast<size_t>(lookup)];
+    if (hit)
+    {
+        counter.Hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        counter.Misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    counter.Nanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+}
+
+void LoadingCacheCounters::AddSolve(LoadingFlag mask, Clock::time_point start)
+{
+    auto& counter = mSolves[static_cast<size_t>(mask)];
+    counter.Hits.fetch_add(1, std::memory_order_relaxed);
+    counter.Nanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+}
+
+void LoadingCacheCounters::AddBoundCheck(GeometricBound bound, Clock::time_point start)
+{
+    auto& counter = mBounds[static_cast<size_t>(bound)];
+    counter.Hits.fetch_add(1, std::memory_order_relaxed);
+    counter.Nanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+}
+
+std::vector<CacheLookupStatistics> LoadingCacheCounters::Lookups() const
+{
+    std::vector<CacheLookupStatistics> lookups;
+    for (size_t mask = 0; mask < NumberMasks; ++mask)
+    {
+        const auto solves = mSolves[mask].Hits.load(std::memory_order_relaxed);
+        const auto averageSolveTime =
+            solves > 0 ? static_cast<double>(mSolves[mask].Nanoseconds.load(std::memory_order_relaxed)) * 1e-9
+                             / static_cast<double>(solves)
+                       : 0.0;
+
+        for (size_t lookup = 0; lookup < NumberLookups; ++lookup)
+        {
+            const auto& counter = mLookups[mask][lookup];
+
+            CacheLookupStatistics statistics;
+            statistics.Mask = static_cast<LoadingFlag>(mask);
+            statistics.Lookup = static_cast<CacheLookup>(lookup);
+            statistics.Hits = counter.Hits.load(std::memory_order_relaxed);
+            statistics.Misses = counter.Misses.load(std::memory_order_relaxed);
+            if (statistics.Hits + statistics.Misses == 0)
+            {
+                continue;
+            }
+
+            statistics.LookupTime = static_cast<double>(counter.Nanoseconds.load(std::memory_order_relaxed)) * 1e-9;
+
+            // Heuristic caches do not save CP calls.
+            if (statistics.Lookup != CacheLookup::HeuristicInfeasibleSequence
+                && statistics.Lookup != CacheLookup::TwoOptCheckedSequence)
+            {
+                statistics.EstimatedSavedTime = static_cast<double>(statistics.Hits) * averageSolveTime;
+            }
+
+            lookups.push_back(statistics);
+        }
+    }
+
+    return lookups;
+}
+
+std::vector<CPSolveStatistics> LoadingCacheCounters::Solves() const
+{
+    std::vector<CPSolveStatistics> solves;
+    for (size_t mask = 0; mask < NumberMasks; ++mask)
+    {
+        const auto calls = mSolves[mask].Hits.load(std::memory_order_relaxed);
+        if (calls == 0)
+        {
+            continue;
+        }
+
+        solves.push_back(CPSolveStatistics{
+            static_cast<LoadingFlag>(mask),
+            calls,
+            static_cast<double>(mSolves[mask].Nanoseconds.load(std::memory_order_relaxed)) * 1e-9});
+    }
+
+    return solves;
+}
+
+std::vector<GeometricBoundStatistics> LoadingCacheCounters::Bounds() const
+{
+    std::vector<GeometricBoundStatistics> bounds;
+    bounds.reserve(NumberBounds);
+    for (size_t bound = 0; bound < NumberBounds; ++bound)
+    {
+        bounds.push_back(GeometricBoundStatistics{
+            static_cast<GeometricBound>(bound),
+            mBounds[bound].Hits.load(std::memory_order_relaxed),
+            static_cast<double>(mBounds[bound].Nanoseconds.load(std::memory_order_relaxed)) * 1e-9});
+    }
+
+    return bounds;
+}
+
+uint64_t LoadingCacheCounters::ElapsedNanoseconds(Clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+}
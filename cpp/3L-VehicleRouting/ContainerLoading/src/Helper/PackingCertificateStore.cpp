@@ -0,0 +1,131 @@
+#include "Helper/PackingCertificateStore.h"
+
+#include <limits>
+#include <mutex>
+
+namespace ContainerLoading
+{
+bool PackingCertificateStore::Insert(RouteHandle handle,
+                                     const Collections::IdVector& route,
+                                     const std::vector<Cuboid>& items)
+{
+    constexpr auto maxCoordinate = static_cast<int>(std::numeric_limits<uint16_t>::max());
+
+    std::vector<Placement> placements;
+    placements.reserve(items.size());
+    uint16_t stop = 0;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const auto& item = items[i];
+        if (item.X < 0 || item.Y < 0 || item.Z < 0 || item.X > maxCoordinate || item.Y > maxCoordinate
+            || item.Z > maxCoordinate)
+        {
+            return false;
+        }
+
+        if (i > 0 && item.GroupId != items[i - 1].GroupId)
+        {
+            stop++;
+        }
+
+        placements.push_back(Placement{static_cast<uint16_t>(item.X),
+                                       static_cast<uint16_t>(item.Y),
+                                       static_cast<uint16_t>(item.Z),
+                                       item.Rotated == Rotation::Yaw,
+                                       stop});
+    }
+
+    std::unique_lock lock(mMutex);
+
+    if (mCertificates.contains(handle))
+    {
+        return false;
+    }
+
+    mCertificates.emplace(
+        handle, Certificate{static_cast<uint32_t>(mPlacements.size()), static_cast<uint32_t>(placements.size())});
+    mPlacements.insert(std::end(mPlacements), std::begin(placements), std::end(placements));
+
+    for (const auto node: route)
+    {
+        if (node >= mLastCertificateByNode.size())
+        {
+            mLastCertificateByNode.resize(node + 1, RouteStore::InvalidHandle);
+        }
+
+        mLastCertificateByNode[node] = handle;
+    }
+
+    return true;
+}
+
+bool PackingCertificateStore::Apply(RouteHandle handle, std::vector<Cuboid>& items) const
+{
+    std::shared_lock lock(mMutex);
+
+    const auto it = mCertificates.find(handle);
+    if (it == std::end(mCertificates) || it->second.NumberItems != items.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        const auto& placement = mPlacements[it->second.Offset + i];
+        auto& item = items[i];
+
+        item.Rotated = placement.Rotated ? Rotation::Yaw : Rotation::None;
+
+        item.X = placement.X;
+        item.Y = placement.Y;
+        item.Z = placement.Z;
+    }
+
+    return true;
+}
+
+std::vector<CertifiedPlacement> PackingCertificateStore::Find(RouteHandle handle) const
+{
+    std::shared_lock lock(mMutex);
+
+    std::vector<CertifiedPlacement> placements;
+    const auto it = mCertificates.find(handle);
+    if (it == std::end(mCertificates))
+    {
+        return placements;
+    }
+
+    placements.reserve(it->second.NumberItems);
+    for (size_t i = 0; i < it->second.NumberItems; ++i)
+    {
+        const auto& placement = mPlacements[it->second.Offset + i];
+        placements.push_back(
+            CertifiedPlacement{placement.X, placement.Y, placement.Z, placement.Rotated, placement.Stop});
+    }
+
+    return placements;
+}
+
+RouteHandle PackingCertificateStore::LastCertificateOfNode(size_t node) const
+{
+    std::shared_lock lock(mMutex);
+    return node < mLastCertificateByNode.size() ? mLastCertificateByNode[node] : RouteStore::InvalidHandle;
+}
+
+size_t PackingCertificateStore::Size() const
+{
+    std::shared_lock lock(mMutex);
+    return mCertificates.size();
+}
+
+size_t PackingCertificateStore::MemoryUsage() const
+{
+    std::shared_lock lock(mMutex);
+
+    // Approximation of one node per certificate in the hash map.
+    return mPlacements.capacity() * sizeof(Placement)
+           + mCertificates.size() * (sizeof(RouteHandle) + sizeof(Certificate) + 2 * sizeof(void*))
+           + mCertificates.bucket_count() * sizeof(void*) + mLastCertificateByNode.capacity() * sizeof(RouteHandle);
+}
+
+}
@@ -0,0 +1,282 @@
+#include "Helper/PersistentLoadingCache.h"
+
+#include <boost/crc.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace ContainerLoading
+{
+namespace
+{
+namespace ipc = boost::interprocess;
+
+struct RecordHeader
+{
+    uint32_t Magic;
+    /// CRC-32 of the header with Checksum = 0 and the node ids of the record.
+    uint32_t Checksum;
+    uint64_t Key;
+    double TimeBudget;
+    uint16_t SetSize;
+    uint16_t Length;
+    uint8_t Mask;
+    uint8_t Status;
+    uint8_t Reserved0;
+    uint8_t Reserved1;
+};
+
+// No padding -> the checksum covers only written bytes.
+static_assert(sizeof(RecordHeader) == 32);
+
+constexpr uint32_t RecordMagic = 0x4345524C; // "LREC"
+
+using NodeId = uint16_t;
+
+uint64_t Combine(uint64_t seed, uint64_t value)
+{
+    // Platform independent variant of boost::hash_combine, the key must be stable across runs and builds.
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+uint32_t ComputeChecksum(RecordHeader header, const char* nodes, size_t nodesSize)
+{
+    header.Checksum = 0;
+
+    boost::crc_32_type crc;
+    crc.process_bytes(&header, sizeof(header));
+    crc.process_bytes(nodes, nodesSize);
+
+    return crc.checksum();
+}
+
+bool IsValidMask(uint8_t mask) { return mask <= static_cast<uint8_t>(LoadingFlag::Complete); }
+
+bool IsValidStatus(uint8_t status)
+{
+    switch (static_cast<LoadingStatus>(status))
+    {
+        case LoadingStatus::FeasOpt:
+        case LoadingStatus::Infeasible:
+        case LoadingStatus::Unknown:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Calls onRecord for each intact record of the file until the first corrupt or truncated record. Returns the size of
+/// the intact part of the file, 0 if the file has no identifier yet.
+size_t ReadRecords(const std::string& filePath,
+                   uint64_t fileIdentifier,
+                   const std::function<void(const RecordHeader&, const char*)>& onRecord)
+{
+    if (!std::filesystem::exists(filePath) || std::filesystem::file_size(filePath) < sizeof(fileIdentifier))
+    {
+        return 0;
+    }
+
+    ipc::file_mapping file(filePath.c_str(), ipc::read_only);
+    ipc::mapped_region region(file, ipc::read_only);
+
+    const auto* data = static_cast<const char*>(region.get_address());
+    const auto size = region.get_size();
+
+    uint64_t identifier = 0;
+    std::memcpy(&identifier, data, sizeof(identifier));
+    if (identifier != fileIdentifier)
+    {
+        throw std::runtime_error("File " + filePath + " is not a loading cache file.");
+    }
+
+    size_t position = sizeof(identifier);
+    while (position + sizeof(RecordHeader) <= size)
+    {
+        RecordHeader header{};
+        std::memcpy(&header, data + position, sizeof(header));
+
+        const auto* nodes = data + position + sizeof(header);
+        const auto nodesSize = header.Length * sizeof(NodeId);
+        if (header.Magic != RecordMagic || position + sizeof(header) + nodesSize > size
+            || header.Checksum != ComputeChecksum(header, nodes, nodesSize))
+        {
+            // Truncated or corrupt record, e.g., from an aborted run.
+            break;
+        }
+
+        onRecord(header, nodes);
+        position += sizeof(header) + nodesSize;
+    }
+
+    return position;
+}
+
+/// Lock file next to the cache file. The cache file itself cannot carry the lock: POSIX record locks are released when
+/// any descriptor of the file is closed by the process, e.g. by the file mapping in ReadRecords.
+ipc::file_lock OpenLockFile(const std::string& filePath)
+{
+    const auto lockFilePath = filePath + ".lock";
+
+    // The file must exist to be locked.
+    if (!std::ofstream(lockFilePath, std::ios::binary | std::ios::app).is_open())
+    {
+        throw std::runtime_error("Loading cache lock file " + lockFilePath + " cannot be opened.");
+    }
+
+    return ipc::file_lock(lockFilePath.c_str());
+}
+}
+
+std::vector<PersistentLoadingEntry> PersistentLoadingCache::Load() const
+{
+    std::vector<PersistentLoadingEntry> entries;
+
+    if (!std::filesystem::exists(mFilePath))
+    {
+        return entries;
+    }
+
+    auto fileLock = OpenLockFile(mFilePath);
+    ipc::sharable_lock lock(fileLock);
+
+    auto addEntry = [this, &entries](const RecordHeader& header, const char* nodes)
+    {
+        // Records of other problems or with values this version does not know are skipped.
+        if (header.Key != mKey || !IsValidMask(header.Mask) || !IsValidStatus(header.Status))
+        {
+            return;
+        }
+
+        PersistentLoadingEntry entry;
+        entry.Mask = static_cast<LoadingFlag>(header.Mask);
+        entry.Status = static_cast<LoadingStatus>(header.Status);
+        entry.SetSize = header.SetSize;
+        entry.TimeBudget = header.TimeBudget;
+        entry.Sequence.reserve(header.Length);
+        for (size_t i = 0; i < header.Length; ++i)
+        {
+            NodeId node = 0;
+            std::memcpy(&node, nodes + i * sizeof(NodeId), sizeof(NodeId));
+            if (entry.SetSize > 0 && node >= entry.SetSize)
+            {
+                return;
+            }
+
+            entry.Sequence.push_back(node);
+        }
+
+        entries.push_back(std::move(entry));
+    };
+
+    ReadRecords(mFilePath, FileIdentifier, addEntry);
+
+    return entries;
+}
+
+void PersistentLoadingCache::Append(const std::vector<PersistentLoadingEntry>& entries) const
+{
+    if (entries.empty())
+    {
+        return;
+    }
+
+    auto fileLock = OpenLockFile(mFilePath);
+    ipc::scoped_lock lock(fileLock);
+
+    // New records behind a corrupt record would never be read -> cut it off.
+    const auto validSize = ReadRecords(mFilePath, FileIdentifier, [](const RecordHeader&, const char*) {});
+    if (std::filesystem::exists(mFilePath) && validSize < std::filesystem::file_size(mFilePath))
+    {
+        std::filesystem::resize_file(mFilePath, validSize);
+    }
+
+    std::ofstream file(mFilePath, std::ios::binary | std::ios::app);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Loading cache file " + mFilePath + " cannot be opened.");
+    }
+
+    if (validSize == 0)
+    {
+        file.write(reinterpret_cast<const char*>(&FileIdentifier), sizeof(FileIdentifier));
+    }
+
+    std::vector<NodeId> nodeIds;
+    for (const auto& entry: entries)
+    {
+        if (entry.Sequence.size() > std::numeric_limits<uint16_t>::max()
+            || entry.SetSize > std::numeric_limits<uint16_t>::max())
+        {
+            continue;
+        }
+
+        nodeIds.assign(std::begin(entry.Sequence), std::end(entry.Sequence));
+        const auto* nodes = reinterpret_cast<const char*>(nodeIds.data());
+        const auto nodesSize = nodeIds.size() * sizeof(NodeId);
+
+        RecordHeader header{};
+        header.Magic = RecordMagic;
+        header.Key = mKey;
+        header.TimeBudget = entry.TimeBudget;
+        header.SetSize = static_cast<uint16_t>(entry.SetSize);
+        header.Length = static_cast<uint16_t>(entry.Sequence.size());
+        header.Mask = static_cast<uint8_t>(entry.Mask);
+        header.Status = static_cast<uint8_t>(entry.Status);
+        header.Checksum = ComputeChecksum(header, nodes, nodesSize);
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(nodes, static_cast<std::streamsize>(nodesSize));
+    }
+
+    // Written completely before the lock is released.
+    file.flush();
+    if (!file)
+    {
+        throw std::runtime_error("Loading cache file " + mFilePath + " cannot be written.");
+    }
+}
+
+uint64_t PersistentLoadingCache::HashContainer(uint64_t seed, const Container& container)
+{
+    seed = Combine(seed, static_cast<uint64_t>(container.Dx));
+    seed = Combine(seed, static_cast<uint64_t>(container.Dy));
+    seed = Combine(seed, static_cast<uint64_t>(container.Dz));
+
+    return HashValue(seed, container.WeightLimit);
+}
+
+uint64_t PersistentLoadingCache::HashItems(uint64_t seed, const std::vector<Cuboid>& items)
+{
+    seed = Combine(seed, items.size());
+    for (const auto& item: items)
+    {
+        seed = Combine(seed, static_cast<uint64_t>(item.Dx));
+        seed = Combine(seed, static_cast<uint64_t>(item.Dy));
+        seed = Combine(seed, static_cast<uint64_t>(item.Dz));
+        seed = HashValue(seed, item.Weight);
+        seed = Combine(seed, static_cast<uint64_t>(item.Fragility));
+        seed = Combine(seed, static_cast<uint64_t>(item.EnableHorizontalRotation));
+        seed = Combine(seed, static_cast<uint64_t>(item.RequireFloorPlacement));
+    }
+
+    return seed;
+}
+
+uint64_t PersistentLoadingCache::HashValue(uint64_t seed, double value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    return Combine(seed, bits);
+}
+
+}
@@ -0,0 +1,150 @@
+#include "Helper/PlacementPatternCache.h"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace ContainerLoading
+{
+size_t PlacementPatternKeyHash::operator()(const PlacementPatternKey& key) const
+{
+    size_t hash = 0;
+    boost::hash_combine(hash, key.ContainerDx);
+    boost::hash_combine(hash, key.ContainerDy);
+    boost::hash_combine(hash, key.ContainerDz);
+    boost::hash_combine(hash, static_cast<int>(key.PatternType));
+    boost::hash_combine(hash, static_cast<int>(key.PatternAxis));
+    for (const auto& item: key.Items)
+    {
+        boost::hash_combine(hash, item.Dx);
+        boost::hash_combine(hash, item.Dy);
+        boost::hash_combine(hash, item.Dz);
+        boost::hash_combine(hash, item.EnableHorizontalRotation);
+    }
+
+    return hash;
+}
+
+void PlacementPatternCache::SetMemoryBudget(size_t bytes)
+{
+    std::lock_guard lock(mMutex);
+    mMemoryBudget = bytes;
+    Evict();
+}
+
+std::vector<boost::dynamic_bitset<>> PlacementPatternCache::GeneratePlacementPatterns(const Container& container,
+                                                                                     const std::vector<Cuboid>& items,
+                                                                                     PlacementPattern patternType,
+                                                                                     Axis axis)
+{
+    auto geometry = [](const Cuboid& item)
+    { return ItemGeometry{item.Dx, item.Dy, item.Dz, item.EnableHorizontalRotation}; };
+
+    // order[k] is the item at position k of the canonical (sorted) item order.
+    std::vector<size_t> order(items.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::ranges::stable_sort(order,
+                             [&items, &geometry](size_t i, size_t j)
+                             { return geometry(items[i]) < geometry(items[j]); });
+
+    PlacementPatternKey key{container.Dx, container.Dy, container.Dz, patternType, axis, {}};
+    key.Items.reserve(items.size());
+    for (const auto i: order)
+    {
+        key.Items.push_back(geometry(items[i]));
+    }
+
+    auto toItemOrder = [&order](const std::vector<boost::dynamic_bitset<>>& sortedPatterns)
+    {
+        std::vector<boost::dynamic_bitset<>> patterns(sortedPatterns.size());
+        for (size_t k = 0; k < order.size(); ++k)
+        {
+            patterns[order[k]] = sortedPatterns[k];
+        }
+
+        return patterns;
+    };
+
+    {
+        std::lock_guard lock(mMutex);
+        if (auto it = mPositions.find(key); it != mPositions.end())
+        {
+            mEntries.splice(std::begin(mEntries), mEntries, it->second);
+            return toItemOrder(it->second->Patterns);
+        }
+    }
+
+    std::vector<Cuboid> sortedItems;
+    sortedItems.reserve(items.size());
+    for (const auto i: order)
+    {
+        sortedItems.push_back(items[i]);
+    }
+
+    auto sortedPatterns = PlacementPointGenerator::GeneratePlacementPatterns(container, sortedItems, patternType, axis);
+    auto patterns = toItemOrder(sortedPatterns);
+
+    std::lock_guard lock(mMutex);
+    if (mPositions.contains(key))
+    {
+        // Generated concurrently by another thread.
+        return patterns;
+    }
+
+    mEntries.push_front(Entry{std::move(key), std::move(sortedPatterns), 0});
+    auto& entry = mEntries.front();
+    entry.MemoryUsage = EntrySize(entry);
+    mPositions.emplace(entry.Key, std::begin(mEntries));
+    mMemoryUsage += entry.MemoryUsage;
+    Evict();
+
+    return patterns;
+}
+
+size_t PlacementPatternCache::Size() const
+{
+    std::lock_guard lock(mMutex);
+    return mPositions.size();
+}
+
+size_t PlacementPatternCache::MemoryUsage() const
+{
+    std::lock_guard lock(mMutex);
+    return mMemoryUsage;
+}
+
+size_t PlacementPatternCache::Evictions() const
+{
+    std::lock_guard lock(mMutex);
+    return mEvictions;
+}
+
+size_t PlacementPatternCache::EntrySize(const Entry& entry)
+{
+    // List node, copy of the key in the hash map, map node and bucket pointers, and heap memory of keys and patterns.
+    size_t size = sizeof(Entry) + sizeof(PlacementPatternKey) + 4 * sizeof(void*)
+                  + 2 * entry.Key.Items.capacity() * sizeof(ItemGeometry)
+                  + entry.Patterns.capacity() * sizeof(boost::dynamic_bitset<>);
+    for (const auto& pattern: entry.Patterns)
+    {
+        size += pattern.num_blocks() * sizeof(boost::dynamic_bitset<>::block_type);
+    }
+
+    return size;
+}
+
+void PlacementPatternCache::Evict()
+{
+    // The most recent entry is always kept, its patterns are needed by the caller anyway.
+    while (mMemoryBudget > 0 && mMemoryUsage > mMemoryBudget && mEntries.size() > 1)
+    {
+        const auto& entry = mEntries.back();
+        mMemoryUsage -= entry.MemoryUsage;
+        mPositions.erase(entry.Key);
+        mEntries.pop_back();
+        mEvictions++;
+    }
+}
+
+}
@@ -0,0 +1,261 @@
+#include "Helper/RouteStore.h"
+
+#include <mutex>
+#include <stdexcept>
+
+namespace ContainerLoading
+{
+void RouteStore::Reserve(size_t numberRoutes, size_t averageLength)
+{
+    const auto routesPerShard = numberRoutes / NumberShards + 1;
+
+    size_t numberSlots = 16;
+    while (numberSlots < 2 * routesPerShard)
+    {
+        numberSlots *= 2;
+    }
+
+    for (auto& shard: mShards)
+    {
+        std::unique_lock lock(shard.Mutex);
+
+        shard.Nodes.reserve(routesPerShard * averageLength);
+        shard.Offsets.reserve(routesPerShard + 1);
+        shard.Fingerprints.reserve(routesPerShard);
+
+        if (numberSlots > shard.Slots.size())
+        {
+            shard.Rehash(numberSlots);
+        }
+    }
+}
+
+RouteHandle RouteStore::Intern(const Collections::IdVector& route)
+{
+    const auto fingerprint = Fingerprint(route);
+    const auto shardIndex = ShardIndex(fingerprint);
+    auto& shard = mShards[shardIndex];
+
+    // Most routes are already stored -> try with shared lock first.
+    {
+        std::shared_lock lock(shard.Mutex);
+        if (!shard.Slots.empty())
+        {
+            const auto local = shard.Slots[shard.FindSlot(fingerprint, route)];
+            if (local != EmptySlot)
+            {
+                return static_cast<RouteHandle>(local * NumberShards + shardIndex);
+            }
+        }
+    }
+
+    std::unique_lock lock(shard.Mutex);
+
+    // Keep load factor <= 0.5.
+    if (2 * (shard.Size() + 1) > shard.Slots.size())
+    {
+        shard.Rehash(shard.Slots.empty() ? 16 : 2 * shard.Slots.size());
+    }
+
+    // Search again, route might have been inserted by another thread in the meantime.
+    const auto slot = shard.FindSlot(fingerprint, route);
+    if (shard.Slots[slot] != EmptySlot)
+    {
+        return static_cast<RouteHandle>(shard.Slots[slot] * NumberShards + shardIndex);
+    }
+
+    if (shard.Size() >= static_cast<size_t>(InvalidHandle / NumberShards))
+    {
+        throw std::runtime_error("Number of routes exceeds range of route handles.");
+    }
+
+    const auto local = static_cast<uint32_t>(shard.Size());
+    for (const auto node: route)
+    {
+        if (node > std::numeric_limits<NodeId>::max())
+        {
+            throw std::runtime_error("Node id exceeds range of route store.");
+        }
+    }
+
+    for (const auto node: route)
+    {
+        shard.Nodes.push_back(static_cast<NodeId>(node));
+    }
+
+    shard.Offsets.push_back(static_cast<uint32_t>(shard.Nodes.size()));
+    shard.Fingerprints.push_back(fingerprint);
+    shard.Slots[slot] = local;
+
+    return static_cast<RouteHandle>(local * NumberShards + shardIndex);
+}
+
+RouteHandle RouteStore::Find(const Collections::IdVector& route) const
+{
+    const auto fingerprint = Fingerprint(route);
+    const auto shardIndex = ShardIndex(fingerprint);
+    const auto& shard = mShards[shardIndex];
+
+    std::shared_lock lock(shard.Mutex);
+    if (shard.Slots.empty())
+    {
+        return InvalidHandle;
+    }
+
+    const auto local = shard.Slots[shard.FindSlot(fingerprint, route)];
+    if (local == EmptySlot)
+    {
+        return InvalidHandle;
+    }
+
+    return static_cast<RouteHandle>(local * NumberShards + shardIndex);
+}
+
+Collections::IdVector RouteStore::Get(RouteHandle handle) const
+{
+    const auto& shard = mShards[handle % NumberShards];
+    const auto local = handle / NumberShards;
+
+    std::shared_lock lock(shard.Mutex);
+    return Collections::IdVector(std::begin(shard.Nodes) + shard.Offsets[local],
+                                 std::begin(shard.Nodes) + shard.Offsets[local + 1]);
+}
+
+size_t RouteStore::Size() const
+{
+    size_t size = 0;
+    for (const auto& shard: mShards)
+    {
+        std::shared_lock lock(shard.Mutex);
+        size += shard.Size();
+    }
+
+    return size;
+}
+
+size_t RouteStore::MemoryUsage() const
+{
+    size_t memory = 0;
+    for (const auto& shard: mShards)
+    {
+        std::shared_lock lock(shard.Mutex);
+        memory += shard.Nodes.capacity() * sizeof(NodeId) + shard.Offsets.capacity() * sizeof(uint32_t)
+                  + shard.Fingerprints.capacity() * sizeof(uint64_t) + shard.Slots.capacity() * sizeof(uint32_t);
+    }
+
+    return memory;
+}
+
+uint64_t RouteStore::Fingerprint(const Collections::IdVector& route)
+{
+    // FNV-1a over node ids with a final avalanche step (splitmix64).
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto node: route)
+    {
+        hash ^= static_cast<uint64_t>(node);
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= route.size();
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+
+    return hash ^ (hash >> 31);
+}
+
+bool RouteStore::Shard::Equals(uint32_t local, const Collections::IdVector& route) const
+{
+    const auto begin = Offsets[local];
+    const auto end = Offsets[local + 1];
+    if (end - begin != route.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < route.size(); ++i)
+    {
+        if (Nodes[begin + i] != route[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t RouteStore::Shard::FindSlot(uint64_t fingerprint, const Collections::IdVector& route) const
+{
+    const auto mask = Slots.size() - 1;
+    for (auto slot = static_cast<size_t>(fingerprint) & mask;; slot = (slot + 1) & mask)
+    {
+        const auto local = Slots[slot];
+        if (local == EmptySlot || (Fingerprints[local] == fingerprint && Equals(local, route)))
+        {
+            return slot;
+        }
+    }
+}
+
+void RouteStore::Shard::Rehash(size_t numberSlots)
+{
+    Slots.assign(numberSlots, EmptySlot);
+
+    const auto mask = numberSlots - 1;
+    for (uint32_t local = 0; local < Size(); ++local)
+    {
+        auto slot = static_cast<size_t>(Fingerprints[local]) & mask;
+        while (Slots[slot] != EmptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        Slots[slot] = local;
+    }
+}
+
+bool RouteSet::Insert(RouteHandle handle)
+{
+    {
+        std::shared_lock lock(mMutex);
+        if (handle < mMembers.size() && mMembers.test(handle))
+        {
+            return false;
+        }
+    }
+
+    std::unique_lock lock(mMutex);
+    if (handle >= mMembers.size())
+    {
+        mMembers.resize(std::max<size_t>(2 * mMembers.size(), handle + 1));
+    }
+
+    if (mMembers.test(handle))
+    {
+        return false;
+    }
+
+    mMembers.set(handle);
+    mSize++;
+
+    return true;
+}
+
+bool RouteSet::Contains(RouteHandle handle) const
+{
+    std::shared_lock lock(mMutex);
+    return handle < mMembers.size() && mMembers.test(handle);
+}
+
+size_t RouteSet::Size() const
+{
+    std::shared_lock lock(mMutex);
+    return mSize;
+}
+
+size_t RouteSet::MemoryUsage() const
+{
+    std::shared_lock lock(mMutex);
+    return mMembers.num_blocks() * sizeof(boost::dynamic_bitset<>::block_type);
+}
+
+}
@@ -0,0 +1,152 @@
+#include "Helper/SequenceContainmentIndex.h"
+
+#include <mutex>
+
+namespace ContainerLoading
+{
+void SequenceContainmentIndex::Insert(const Collections::IdVector& sequence)
+{
+    std::unique_lock lock(mMutex);
+
+    const auto id = mOffsets.size() - 1;
+    mNodes.insert(std::end(mNodes), std::begin(sequence), std::end(sequence));
+    mOffsets.push_back(mNodes.size());
+
+    if (sequence.empty())
+    {
+        mContainsEmptySequence = true;
+        return;
+    }
+
+    for (const auto node: sequence)
+    {
+        if (node >= mSequencesByNode.size())
+        {
+            mSequencesByFirstNode.resize(node + 1);
+            mSequencesByNode.resize(node + 1);
+        }
+
+        mSequencesByNode[node].push_back(id);
+    }
+
+    mSequencesByFirstNode[sequence.front()].push_back(id);
+}
+
+size_t SequenceContainmentIndex::Size() const
+{
+    std::shared_lock lock(mMutex);
+    return mOffsets.size() - 1;
+}
+
+size_t SequenceContainmentIndex::MemoryUsage() const
+{
+    std::shared_lock lock(mMutex);
+
+    // Each sequence is registered once per node and once by its first node.
+    return (mNodes.capacity() + mOffsets.capacity() + mNodes.size() + mOffsets.size()) * sizeof(size_t)
+           + 2 * mSequencesByNode.capacity() * sizeof(std::vector<size_t>);
+}
+
+bool SequenceContainmentIndex::ContainsSubsequenceOf(const Collections::IdVector& sequence) const
+{
+    std::shared_lock lock(mMutex);
+
+    if (mContainsEmptySequence)
+    {
+        return true;
+    }
+
+    for (const auto node: sequence)
+    {
+        if (node >= mSequencesByFirstNode.size())
+        {
+            continue;
+        }
+
+        for (const auto id: mSequencesByFirstNode[node])
+        {
+            if (Length(id) > sequence.size())
+            {
+                continue;
+            }
+
+            if (IsSubsequence(id, sequence))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SequenceContainmentIndex::ContainsSupersequenceOf(const Collections::IdVector& sequence) const
+{
+    std::shared_lock lock(mMutex);
+
+    if (sequence.empty())
+    {
+        return mOffsets.size() > 1;
+    }
+
+    // Every supersequence contains all nodes of sequence -> scan the shortest posting list only.
+    const std::vector<size_t>* candidates = nullptr;
+    for (const auto node: sequence)
+    {
+        if (node >= mSequencesByNode.size() || mSequencesByNode[node].empty())
+        {
+            return false;
+        }
+
+        if (candidates == nullptr || mSequencesByNode[node].size() < candidates->size())
+        {
+            candidates = &mSequencesByNode[node];
+        }
+    }
+
+    for (const auto id: *candidates)
+    {
+        if (Length(id) < sequence.size())
+        {
+            continue;
+        }
+
+        if (IsSupersequence(id, sequence))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SequenceContainmentIndex::IsSubsequence(size_t id, const Collections::IdVector& sequence) const
+{
+    auto position = mOffsets[id];
+    const auto end = mOffsets[id + 1];
+    for (size_t i = 0; i < sequence.size() && position < end; ++i)
+    {
+        if (sequence[i] == mNodes[position])
+        {
+            position++;
+        }
+    }
+
+    return position == end;
+}
+
+bool SequenceContainmentIndex::IsSupersequence(size_t id, const Collections::IdVector& sequence) const
+{
+    size_t i = 0;
+    for (auto position = mOffsets[id]; position < mOffsets[id + 1] && i < sequence.size(); ++position)
+    {
+        if (mNodes[position] == sequence[i])
+        {
+            i++;
+        }
+    }
+
+    return i == sequence.size();
+}
+
+}
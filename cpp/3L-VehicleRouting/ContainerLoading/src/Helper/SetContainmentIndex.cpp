@@ -0,0 +1,160 @@
+#include "Helper/SetContainmentIndex.h"
+
+#include <mutex>
+
+namespace ContainerLoading
+{
+void SetContainmentIndex::Reserve(size_t size)
+{
+    std::unique_lock lock(mMutex);
+
+    mSets.reserve(size);
+    mCardinalities.reserve(size);
+    mExactSets.reserve(size);
+}
+
+void SetContainmentIndex::ResizeElementLists(size_t size)
+{
+    if (mSetsByElement.size() >= size)
+    {
+        return;
+    }
+
+    mSetsByMinElement.resize(size);
+    mSetsByElement.resize(size);
+}
+
+bool SetContainmentIndex::Insert(const boost::dynamic_bitset<>& set)
+{
+    std::unique_lock lock(mMutex);
+
+    if (!mExactSets.insert(set).second)
+    {
+        return false;
+    }
+
+    const auto id = mSets.size();
+    mSets.push_back(set);
+    mCardinalities.push_back(set.count());
+
+    auto minElement = set.find_first();
+    if (minElement == boost::dynamic_bitset<>::npos)
+    {
+        mContainsEmptySet = true;
+        return true;
+    }
+
+    ResizeElementLists(set.size());
+
+    mSetsByMinElement[minElement].push_back(id);
+    for (auto e = minElement; e != boost::dynamic_bitset<>::npos; e = set.find_next(e))
+    {
+        mSetsByElement[e].push_back(id);
+    }
+
+    return true;
+}
+
+bool SetContainmentIndex::Contains(const boost::dynamic_bitset<>& set) const
+{
+    std::shared_lock lock(mMutex);
+    return mExactSets.contains(set);
+}
+
+size_t SetContainmentIndex::Size() const
+{
+    std::shared_lock lock(mMutex);
+    return mSets.size();
+}
+
+size_t SetContainmentIndex::MemoryUsage() const
+{
+    std::shared_lock lock(mMutex);
+
+    size_t setBlocks = 0;
+    size_t postings = 0;
+    for (const auto& set: mSets)
+    {
+        setBlocks += set.num_blocks();
+        postings += set.count();
+    }
+
+    // Each set is stored twice (list and exact lookup) and registered once per element and once by its minimum.
+    return 2 * setBlocks * sizeof(boost::dynamic_bitset<>::block_type)
+           + mSets.capacity() * (2 * sizeof(boost::dynamic_bitset<>) + sizeof(size_t))
+           + (postings + mSets.size()) * sizeof(size_t)
+           + 2 * mSetsByElement.capacity() * sizeof(std::vector<size_t>);
+}
+
+bool SetContainmentIndex::ContainsSubsetOf(const boost::dynamic_bitset<>& set) const
+{
+    std::shared_lock lock(mMutex);
+
+    if (mContainsEmptySet)
+    {
+        return true;
+    }
+
+    const auto cardinality = set.count();
+    for (auto e = set.find_first(); e != boost::dynamic_bitset<>::npos && e < mSetsByMinElement.size();
+         e = set.find_next(e))
+    {
+        for (const auto id: mSetsByMinElement[e])
+        {
+            if (mCardinalities[id] > cardinality)
+            {
+                continue;
+            }
+
+            if (mSets[id].is_subset_of(set))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SetContainmentIndex::ContainsSupersetOf(const boost::dynamic_bitset<>& set) const
+{
+    std::shared_lock lock(mMutex);
+
+    if (set.none())
+    {
+        return !mSets.empty();
+    }
+
+    // Every superset of set contains all of its elements -> scan the shortest posting list only.
+    const std::vector<size_t>* candidates = nullptr;
+    for (auto e = set.find_first(); e != boost::dynamic_bitset<>::npos; e = set.find_next(e))
+    {
+        if (e >= mSetsByElement.size() || mSetsByElement[e].empty())
+        {
+            return false;
+        }
+
+        if (candidates == nullptr || mSetsByElement[e].size() < candidates->size())
+        {
+            candidates = &mSetsByElement[e];
+        }
+    }
+
+    const auto cardinality = set.count();
+    for (const auto id: *candidates)
+    {
+        if (mCardinalities[id] < cardinality)
+        {
+            continue;
+        }
+
+        if (set.is_subset_of(mSets[id]))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
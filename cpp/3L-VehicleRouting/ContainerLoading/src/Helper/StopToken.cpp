@@ -0,0 +1,49 @@
+#include "Helper/StopToken.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ContainerLoading
+{
+void StopToken::SetTimeLimit(double timeLimit)
+{
+    const auto maxTimeLimit = std::chrono::duration<double>(Clock::duration::max() - Clock::now().time_since_epoch());
+    if (timeLimit >= maxTimeLimit.count())
+    {
+        mDeadline = Clock::duration::max().count();
+        return;
+    }
+
+    const auto duration =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(timeLimit, 0.0)));
+    mDeadline = (Clock::now() + duration).time_since_epoch().count();
+}
+
+bool StopToken::StopRequested() const
+{
+    return mStopRequested.load(std::memory_order_relaxed) || Clock::now().time_since_epoch().count() >= mDeadline;
+}
+
+double StopToken::RemainingTime() const
+{
+    if (mStopRequested.load(std::memory_order_relaxed))
+    {
+        return 0.0;
+    }
+
+    const auto deadline = mDeadline.load();
+    if (deadline == Clock::duration::max().count())
+    {
+        return std::numeric_limits<double>::max();
+    }
+
+    const auto remaining = Clock::duration(deadline) - Clock::now().time_since_epoch();
+    return std::max(std::chrono::duration<double>(remaining).count(), 0.0);
+}
+
+double StopToken::LimitRuntime(double maxRuntime) const
+{
+    return std::min(maxRuntime, RemainingTime());
+}
+
+}
@@ -1,5 +1,10 @@
 #include "LoadingChecker.h"
-#include "Algorithms/SingleContainer/OPP_CP_3D.h"
+#include "Algorithms/SingleContainer/GeometricBounds.h"
+#include "Algorithms/SingleContainer/OPP_EP_3D.h"
+
+#include <algorithm>
+#include <future>
+#include <memory>
 
 namespace ContainerLoading
 {
@@ -72,34 +77,224 @@ LoadingStatus LoadingChecker::ConstraintProgrammingSolver(PackingType packingTyp
 
     auto loadingMask = BuildMask(packingType);
 
-    auto precheckStatus = GetPrecheckStatusCP(stopIds, set, loadingMask, isCallTypeExact);
+    auto precheckStatus =
+        GetPrecheckStatusWithBounds(container, set, stopIds, items, loadingMask, isCallTypeExact, maxRuntime);
     if (precheckStatus != LoadingStatus::Invalid)
     {
         return precheckStatus;
     }
 
+    maxRuntime = mStopToken.LimitRuntime(maxRuntime);
+    if (maxRuntime < 0.0 + 1e-5)
+    {
+        return LoadingStatus::Invalid;
+    }
+
     auto numberStops = stopIds.size();
+    const auto enableReuse = Parameters.CPSolver.ReusableModels > 0;
+    auto cachedModel = mCPModels.FindOrCreate(
+        stopIds,
+        container,
+        items,
+        [this, &container, &stopIds, &items, numberStops, loadingMask, enableReuse]()
+        {
+            auto model = std::make_unique<ContainerLoadingCP>(Parameters.CPSolver,
+                                                              container,
+                                                              items,
+                                                              numberStops,
+                                                              enableReuse ? mUsedLoadingMasks
+                                                                          : std::vector<LoadingFlag>{loadingMask},
+                                                              Parameters.LoadingProblem.SupportArea);
+            model->SetSolutionHint(DetermineSolutionHint(stopIds, items));
+            model->SetPlacementPatternCache(&mPlacementPatterns);
+            model->SetStopToken(&mStopToken);
+            return model;
+        });
+
+    // Held until the packing is extracted, the response of the model is overwritten by the next solve.
+    std::lock_guard modelLock(cachedModel->Mutex);
+    auto& containerLoadingCP = *cachedModel->Model;
+
+    const auto solveStart = LoadingCacheCounters::Clock::now();
+    auto status = containerLoadingCP.Solve(loadingMask, maxRuntime);
+    mCacheCounters.AddSolve(loadingMask, solveStart);
+
+    if (status == LoadingStatus::Invalid)
+    {
+        throw std::runtime_error("Loading status invalid in CP model!");
+    }
+
+    if (status == LoadingStatus::Unknown && mStopToken.StopRequested())
+    {
+        return isCallTypeExact ? LoadingStatus::Invalid : LoadingStatus::Unknown;
+    }
+
+    return AddSolveStatus(containerLoadingCP, set, stopIds, items, loadingMask, status, isCallTypeExact, maxRuntime);
+}
+
+std::vector<LoadingStatus> LoadingChecker::RaceConstraintProgrammingSolvers(const std::vector<CPRaceEntry>& entries,
+                                                                            const Container& container,
+                                                                            const Collections::IdVector& stopIds,
+                                                                            const std::vector<Cuboid>& items)
+{
+    if (entries.empty())
+    {
+        return {};
+    }
+
+    // The remainder of the workers goes to the first entries -> all configured workers are used.
+    const auto numberEntries = static_cast<int>(entries.size());
+    const auto threadsPerEntry = Parameters.CPSolver.Threads / numberEntries;
+    const auto remainingThreads = Parameters.CPSolver.Threads % numberEntries;
+
+    std::atomic<bool> stopFlag = false;
+    auto solve = [this, &container, &stopIds, &items, &stopFlag](const CPRaceEntry& entry, int threads)
+    {
+        try
+        {
+            auto status = SolveRaceEntry(entry, container, stopIds, items, threads, stopFlag);
+
+            if ((status == LoadingStatus::Infeasible && entry.StopIfInfeasible)
+                || (status == LoadingStatus::FeasOpt && entry.StopIfFeasible))
+            {
+                stopFlag = true;
+            }
+
+            return status;
+        }
+        catch (...)
+        {
+            stopFlag = true;
+            throw;
+        }
+    };
+
+    std::vector<std::future<LoadingStatus>> results;
+    results.reserve(entries.size());
+    for (int k = 0; k < numberEntries; ++k)
+    {
+        const auto threads = std::max(1, threadsPerEntry + (k < remainingThreads ? 1 : 0));
+        results.push_back(
+            std::async(std::launch::async, solve, std::cref(entries[static_cast<size_t>(k)]), threads));
+    }
+
+    std::vector<LoadingStatus> statuses;
+    statuses.reserve(entries.size());
+    for (auto& result: results)
+    {
+        statuses.push_back(result.get());
+    }
+
+    return statuses;
+}
+
+LoadingStatus LoadingChecker::SolveRaceEntry(const CPRaceEntry& entry,
+                                             const Container& container,
+                                             const Collections::IdVector& stopIds,
+                                             const std::vector<Cuboid>& items,
+                                             int threads,
+                                             std::atomic<bool>& stopFlag)
+{
+    if (entry.MaxRuntime < 0.0 + 1e-5)
+    {
+        return LoadingStatus::Invalid;
+    }
+
+    auto loadingMask = BuildMask(entry.Type);
+
+    auto precheckStatus = GetPrecheckStatusWithBounds(
+        container, entry.Set, stopIds, items, loadingMask, entry.IsCallTypeExact, entry.MaxRuntime);
+    if (precheckStatus != LoadingStatus::Invalid)
+    {
+        return precheckStatus;
+    }
+
+    const auto maxRuntime = mStopToken.LimitRuntime(entry.MaxRuntime);
+    if (maxRuntime < 0.0 + 1e-5)
+    {
+        return LoadingStatus::Unknown;
+    }
+
+    // Own model: the cached model of the route is solved by one thread at a time.
     auto containerLoadingCP = ContainerLoadingCP(Parameters.CPSolver,
                                                  container,
                                                  items,
-                                                 numberStops,
+                                                 stopIds.size(),
                                                  loadingMask,
                                                  Parameters.LoadingProblem.SupportArea,
                                                  maxRuntime);
+    containerLoadingCP.SetSolutionHint(DetermineSolutionHint(stopIds, items));
+    containerLoadingCP.SetPlacementPatternCache(&mPlacementPatterns);
+    containerLoadingCP.SetStopToken(&mStopToken);
 
-    auto status = containerLoadingCP.Solve();
+    const auto solveStart = LoadingCacheCounters::Clock::now();
+    auto status = containerLoadingCP.Solve(loadingMask, maxRuntime, threads, &stopFlag);
+    mCacheCounters.AddSolve(loadingMask, solveStart);
 
     if (status == LoadingStatus::Invalid)
     {
         throw std::runtime_error("Loading status invalid in CP model!");
     }
 
+    // Stopped before its time limit -> not an unknown result w.r.t. the time budget.
+    if (status == LoadingStatus::Unknown && (stopFlag || mStopToken.StopRequested()))
+    {
+        return LoadingStatus::Unknown;
+    }
+
+    return AddSolveStatus(
+        containerLoadingCP, entry.Set, stopIds, items, loadingMask, status, entry.IsCallTypeExact, maxRuntime);
+}
+
+LoadingStatus LoadingChecker::GetPrecheckStatusWithBounds(const Container& container,
+                                                          const boost::dynamic_bitset<>& set,
+                                                          const Collections::IdVector& stopIds,
+                                                          const std::vector<Cuboid>& items,
+                                                          LoadingFlag mask,
+                                                          bool isCallTypeExact,
+                                                          double maxRuntime)
+{
+    auto precheckStatus = GetPrecheckStatusCP(stopIds, set, mask, isCallTypeExact, maxRuntime);
+    if (precheckStatus != LoadingStatus::Invalid)
+    {
+        return precheckStatus;
+    }
+
+    const auto boundStart = LoadingCacheCounters::Clock::now();
+    const auto violatedBound =
+        GeometricBounds(container, items, mask, Parameters.LoadingProblem.SupportArea).FindViolatedBound();
+    mCacheCounters.AddBoundCheck(violatedBound, boundStart);
+    if (violatedBound != GeometricBound::None)
+    {
+        AddStatus(stopIds, set, mask, LoadingStatus::Infeasible, maxRuntime);
+        return LoadingStatus::Infeasible;
+    }
+
+    return LoadingStatus::Invalid;
+}
+
+LoadingStatus LoadingChecker::AddSolveStatus(const ContainerLoadingCP& containerLoadingCP,
+                                             const boost::dynamic_bitset<>& set,
+                                             const Collections::IdVector& stopIds,
+                                             const std::vector<Cuboid>& items,
+                                             LoadingFlag mask,
+                                             LoadingStatus status,
+                                             bool isCallTypeExact,
+                                             double maxRuntime)
+{
     if (isCallTypeExact && status == LoadingStatus::Unknown)
     {
         return LoadingStatus::Invalid;
     }
 
-    AddStatus(stopIds, set, loadingMask, status);
+    AddStatus(stopIds, set, mask, status, maxRuntime);
+
+    if (status == LoadingStatus::FeasOpt && mask == Parameters.LoadingProblem.LoadingFlags)
+    {
+        auto packedItems = items;
+        containerLoadingCP.ExtractPacking(packedItems);
+        AddPackingCertificate(stopIds, packedItems);
+    }
 
     return status;
 }
@@ -126,8 +321,12 @@ LoadingStatus LoadingChecker::ConstraintProgrammingSolverGetPacking(PackingType
                                                  loadingMask,
                                                  Parameters.LoadingProblem.SupportArea,
                                                  maxRuntime);
+    containerLoadingCP.SetSolutionHint(DetermineSolutionHint(stopIds, items));
+    containerLoadingCP.SetPlacementPatternCache(&mPlacementPatterns);
 
+    const auto solveStart = LoadingCacheCounters::Clock::now();
     auto status = containerLoadingCP.Solve();
+    mCacheCounters.AddSolve(loadingMask, solveStart);
 
     if (status == LoadingStatus::Invalid)
     {
@@ -142,6 +341,115 @@ LoadingStatus LoadingChecker::ConstraintProgrammingSolverGetPacking(PackingType
     return status;
 }
 
+Collections::IdVector LoadingChecker::DetermineInfeasibleCore(PackingType packingType,
+                                                              const Container& container,
+                                                              const boost::dynamic_bitset<>& set,
+                                                              const Collections::IdVector& stopIds,
+                                                              const std::vector<Cuboid>& items,
+                                                              double maxRuntime)
+{
+    maxRuntime = mStopToken.LimitRuntime(maxRuntime);
+    if (maxRuntime < 0.0 + 1e-5 || stopIds.empty())
+    {
+        return {};
+    }
+
+    auto loadingMask = BuildMask(packingType);
+
+    auto numberStops = stopIds.size();
+    auto containerLoadingCP = ContainerLoadingCP(Parameters.CPSolver,
+                                                 container,
+                                                 items,
+                                                 numberStops,
+                                                 loadingMask,
+                                                 Parameters.LoadingProblem.SupportArea,
+                                                 maxRuntime);
+    containerLoadingCP.EnableCustomerAssumptions();
+    containerLoadingCP.SetPlacementPatternCache(&mPlacementPatterns);
+    containerLoadingCP.SetStopToken(&mStopToken);
+
+    const auto solveStart = LoadingCacheCounters::Clock::now();
+    auto status = containerLoadingCP.Solve();
+    mCacheCounters.AddSolve(loadingMask, solveStart);
+
+    if (status == LoadingStatus::Invalid)
+    {
+        throw std::runtime_error("Loading status invalid in CP model!");
+    }
+
+    if (status != LoadingStatus::Infeasible)
+    {
+        return {};
+    }
+
+    AddStatus(stopIds, set, loadingMask, LoadingStatus::Infeasible, maxRuntime);
+
+    // Group id g belongs to stop numberStops - 1 - g, see SelectItems.
+    std::vector<bool> isInCore(numberStops, false);
+    for (const auto customer: containerLoadingCP.ExtractInfeasibleCustomers())
+    {
+        isInCore[numberStops - 1 - customer] = true;
+    }
+
+    Collections::IdVector core;
+    for (size_t i = 0; i < numberStops; ++i)
+    {
+        if (isInCore[i])
+        {
+            core.push_back(stopIds[i]);
+        }
+    }
+
+    // Infeasibility without any customer assumption (e.g. an item that does not fit) is not attributed to customers.
+    if (core.empty() || core.size() == numberStops)
+    {
+        return stopIds;
+    }
+
+    auto coreSet = boost::dynamic_bitset<>(set.size());
+    for (const auto node: core)
+    {
+        coreSet.set(node);
+    }
+
+    // Placement patterns contain all patterns of a subset of the items, except meet-in-the-middle patterns. Then, the
+    // core is only proven infeasible with the patterns of the route and is solved again with its own items.
+    const auto [patternTypeX, patternTypeY, patternTypeZ] =
+        PlacementPointGenerator::SelectMinimalFeasiblePatternType(loadingMask);
+    if (patternTypeX != PlacementPattern::MeetInTheMiddle && patternTypeY != PlacementPattern::MeetInTheMiddle
+        && patternTypeZ != PlacementPattern::MeetInTheMiddle)
+    {
+        AddStatus(core, coreSet, loadingMask, LoadingStatus::Infeasible, maxRuntime);
+        return core;
+    }
+
+    std::vector<Cuboid> coreItems;
+    coreItems.reserve(items.size());
+    for (size_t i = 0, corePosition = 0; i < numberStops; ++i)
+    {
+        if (!isInCore[i])
+        {
+            continue;
+        }
+
+        for (const auto& item: items)
+        {
+            if (item.GroupId == numberStops - 1 - i)
+            {
+                coreItems.push_back(item);
+                coreItems.back().GroupId = core.size() - 1 - corePosition;
+            }
+        }
+
+        corePosition++;
+    }
+
+    auto coreStatus =
+        ConstraintProgrammingSolver(packingType, container, coreSet, core, coreItems, false, maxRuntime);
+
+    return coreStatus == LoadingStatus::Infeasible ? core : stopIds;
+}
+
 LoadingStatus LoadingChecker::HeuristicCompleteCheck(const Container& container,
                                                      const boost::dynamic_bitset<>& set,
                                                      const Collections::IdVector& stopIds,
@@ -169,19 +477,54 @@ void LoadingChecker::SetBinPackingModel(GRBEnv* env,
     mBinPacking1D = std::make_unique<BinPacking1D>(env, containers, nodes, outputPath);
 }
 
-LoadingStatus LoadingChecker::RunLoadingHeuristic(PackingType packingType [[maybe_unused]],
-                                                  const Container& container [[maybe_unused]],
-                                                  const Collections::IdVector& stopIds [[maybe_unused]],
-                                                  const std::vector<Cuboid>& items [[maybe_unused]])
+LoadingStatus LoadingChecker::RunLoadingHeuristic(PackingType packingType,
+                                                  const Container& container,
+                                                  const Collections::IdVector& stopIds,
+                                                  const std::vector<Cuboid>& items)
 {
-    // Implement heuristic here.
-    return LoadingStatus::Invalid;
+    auto loadingMask = BuildMask(packingType);
+
+    auto containerLoadingEP =
+        ContainerLoadingEP(container, items, loadingMask, Parameters.LoadingProblem.SupportArea);
+    auto status = containerLoadingEP.Solve();
+
+    // Only feasible results are proven, a failed heuristic is not tried again for this sequence.
+    if (status == LoadingStatus::Infeasible)
+    {
+        if (loadingMask == Parameters.LoadingProblem.LoadingFlags)
+        {
+            AddInfeasibleSequenceEP(stopIds);
+        }
+
+        return LoadingStatus::Infeasible;
+    }
+
+    if (loadingMask == Parameters.LoadingProblem.LoadingFlags)
+    {
+        AddFeasibleRoute(stopIds);
+
+        auto packedItems = items;
+        containerLoadingEP.ExtractPacking(packedItems);
+        AddPackingCertificate(stopIds, packedItems);
+    }
+    else if (IsSet(loadingMask, LoadingFlag::Sequence)
+             && mFeasSequences.at(loadingMask).Insert(mRouteStore.Intern(stopIds)))
+    {
+        AddToSequenceIndex(mFeasSequenceIndex, stopIds, loadingMask);
+    }
+
+    return LoadingStatus::FeasOpt;
 }
 
-int LoadingChecker::SolveBinPackingApproximation() const { return mBinPacking1D->Solve(); }
+int LoadingChecker::SolveBinPackingApproximation() const
+{
+    std::lock_guard lock(mBinPackingMutex);
+    return mBinPacking1D->Solve();
+}
 
 int LoadingChecker::ReSolveBinPackingApproximation(const boost::dynamic_bitset<>& selectedGroups) const
 {
+    std::lock_guard lock(mBinPackingMutex);
     return mBinPacking1D->ReSolve(selectedGroups);
 }
 
@@ -224,52 +567,172 @@ int LoadingChecker::DetermineMinVehiclesBinPacking(bool enableLifting,
 
 bool LoadingChecker::CustomerCombinationInfeasible(const boost::dynamic_bitset<>& customersInRoute) const
 {
-    for (const auto& customerCombination: mInfeasibleCustomerCombinations)
-    {
-        auto intersection = customersInRoute & customerCombination;
-
-        if (intersection.count() != customerCombination.count())
-        {
-            continue;
-        }
+    return mInfeasibleCustomerCombinations.ContainsSubsetOf(customersInRoute);
+}
 
-        return true;
-    }
+bool LoadingChecker::RouteSetContains(const RouteSet& routes, const Collections::IdVector& sequence) const
+{
+    const auto handle = mRouteStore.Find(sequence);
 
-    return false;
+    return handle != RouteStore::InvalidHandle && routes.Contains(handle);
 }
 
 bool LoadingChecker::SequenceIsHeuristicallyInfeasibleEP(const Collections::IdVector& sequence) const
 {
-    return mEPHeurInfSequences.contains(sequence);
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = mEPHeurInfSequences.Contains(sequence);
+    mCacheCounters.AddLookup(
+        Parameters.LoadingProblem.LoadingFlags, CacheLookup::HeuristicInfeasibleSequence, hit, start);
+
+    return hit;
 }
 
 void LoadingChecker::AddInfeasibleCombination(const boost::dynamic_bitset<>& customersInRoute)
 {
-    mInfeasibleCustomerCombinations.emplace_back(customersInRoute);
+    mInfeasibleCustomerCombinations.Insert(customersInRoute);
 }
 
-Collections::SequenceVector LoadingChecker::GetFeasibleRoutes() const { return mCompleteFeasSeq; };
+Collections::SequenceVector LoadingChecker::GetFeasibleRoutes(size_t firstIndex) const
+{
+    std::vector<RouteHandle> handles;
+    {
+        std::lock_guard lock(mCompleteFeasSeqMutex);
+        if (firstIndex < mCompleteFeasSeq.size())
+        {
+            handles.assign(std::begin(mCompleteFeasSeq) + firstIndex, std::end(mCompleteFeasSeq));
+        }
+    }
+
+    Collections::SequenceVector routes;
+    routes.reserve(handles.size());
+    for (const auto handle: handles)
+    {
+        routes.emplace_back(mRouteStore.Get(handle));
+    }
 
-size_t LoadingChecker::GetNumberOfFeasibleRoutes() const { return mCompleteFeasSeq.size(); };
+    return routes;
+};
 
-size_t LoadingChecker::GetSizeInfeasibleCombinations() const { return mInfeasibleCustomerCombinations.size(); };
+size_t LoadingChecker::GetNumberOfFeasibleRoutes() const
+{
+    std::lock_guard lock(mCompleteFeasSeqMutex);
+    return mCompleteFeasSeq.size();
+};
+
+size_t LoadingChecker::GetSizeInfeasibleCombinations() const { return mInfeasibleCustomerCombinations.Size(); };
+
+CombinationAntichainStatistics LoadingChecker::GetInfeasibleCombinationStatistics() const
+{
+    return mInfeasibleCustomerCombinations.Statistics();
+}
 
 void LoadingChecker::AddFeasibleSequenceFromOutside(const Collections::IdVector& route) { AddFeasibleRoute(route); }
 
 bool LoadingChecker::RouteIsInFeasSequences(const Collections::IdVector& route) const
 {
-    return mFeasSequences.at(Parameters.LoadingProblem.LoadingFlags).contains(route);
+    return SequenceIsFeasible(route, Parameters.LoadingProblem.LoadingFlags);
+}
+
+bool LoadingChecker::GetPackingCertificate(const Collections::IdVector& route, std::vector<Cuboid>& items) const
+{
+    const auto handle = mRouteStore.Find(route);
+    if (handle == RouteStore::InvalidHandle)
+    {
+        return false;
+    }
+
+    return mPackingCertificates.Apply(handle, items);
 }
 
 void LoadingChecker::AddSequenceCheckedTwoOpt(const Collections::IdVector& sequence)
 {
-    mTwoOptCheckedSequences.insert(sequence);
+    mTwoOptCheckedSequences.Insert(sequence);
 }
 
 bool LoadingChecker::SequenceIsCheckedTwoOpt(const Collections::IdVector& sequence) const
 {
-    return mTwoOptCheckedSequences.contains(sequence);
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = mTwoOptCheckedSequences.Contains(sequence);
+    mCacheCounters.AddLookup(Parameters.LoadingProblem.LoadingFlags, CacheLookup::TwoOptCheckedSequence, hit, start);
+
+    return hit;
+}
+
+void LoadingChecker::SetMemoryBudgets()
+{
+    constexpr double bytesPerMB = 1024.0 * 1024.0;
+    const auto& cacheParams = Parameters.LoadingCache;
+
+    // Budget of unknown results is shared evenly between sequences and sets of all masks.
+    const auto numberUnknownCaches = static_cast<double>(mUnkSequences.size() + mUnknownSets.size());
+    const auto unknownBudget = static_cast<size_t>(cacheParams.MaxMemoryUnknown * bytesPerMB / numberUnknownCaches);
+    for (auto& [mask, cache]: mUnkSequences)
+    {
+        cache.SetMemoryBudget(unknownBudget);
+    }
+
+    for (auto& [mask, cache]: mUnknownSets)
+    {
+        cache.SetMemoryBudget(unknownBudget);
+    }
+
+    mTwoOptCheckedSequences.SetMemoryBudget(static_cast<size_t>(cacheParams.MaxMemoryTwoOptChecked * bytesPerMB));
+    mEPHeurInfSequences.SetMemoryBudget(static_cast<size_t>(cacheParams.MaxMemoryHeuristicInfeasible * bytesPerMB));
+    mPlacementPatterns.SetMemoryBudget(static_cast<size_t>(cacheParams.MaxMemoryPlacementPatterns * bytesPerMB));
+}
+
+const LoadingCacheCounters& LoadingChecker::GetCacheCounters() const { return mCacheCounters; }
+
+std::vector<LoadingCacheStatistics> LoadingChecker::GetCacheStatistics() const
+{
+    auto sumOverMasks = [](const std::string& name, const auto& caches)
+    {
+        LoadingCacheStatistics statistics{name};
+        for (const auto& [mask, cache]: caches)
+        {
+            statistics.Entries += cache.Size();
+            statistics.MemoryUsage += cache.MemoryUsage();
+        }
+
+        return statistics;
+    };
+
+    auto fromClockCache = [](const std::string& name, const auto& cache)
+    { return LoadingCacheStatistics{name, cache.Size(), cache.MemoryUsage(), cache.Evictions()}; };
+
+    auto unknownSequences = sumOverMasks("UnknownSequences", mUnkSequences);
+    auto unknownSets = sumOverMasks("UnknownSets", mUnknownSets);
+    for (const auto& [mask, cache]: mUnkSequences)
+    {
+        unknownSequences.Evictions += cache.Evictions();
+    }
+
+    for (const auto& [mask, cache]: mUnknownSets)
+    {
+        unknownSets.Evictions += cache.Evictions();
+    }
+
+    return {
+        LoadingCacheStatistics{"RouteStore", mRouteStore.Size(), mRouteStore.MemoryUsage(), 0},
+        sumOverMasks("FeasibleSequences", mFeasSequences),
+        sumOverMasks("InfeasibleSequences", mInfSequences),
+        sumOverMasks("FeasibleSequenceIndex", mFeasSequenceIndex),
+        sumOverMasks("InfeasibleSequenceIndex", mInfSequenceIndex),
+        sumOverMasks("FeasibleSets", mFeasibleSets),
+        sumOverMasks("InfeasibleSets", mInfSets),
+        LoadingCacheStatistics{"InfeasibleCombinations", mInfeasibleCustomerCombinations.Size(), 0, 0},
+        unknownSequences,
+        unknownSets,
+        fromClockCache("TwoOptCheckedSequences", mTwoOptCheckedSequences),
+        fromClockCache("HeuristicInfeasibleSequences", mEPHeurInfSequences),
+        LoadingCacheStatistics{
+            "PackingCertificates", mPackingCertificates.Size(), mPackingCertificates.MemoryUsage(), 0},
+        LoadingCacheStatistics{"CPModels", mCPModels.Size(), 0, mCPModels.Evictions()},
+        LoadingCacheStatistics{"PlacementPatterns",
+                               mPlacementPatterns.Size(),
+                               mPlacementPatterns.MemoryUsage(),
+                               mPlacementPatterns.Evictions()},
+    };
 }
 
 boost::dynamic_bitset<> LoadingChecker::MakeBitset(size_t size, const Collections::IdVector& sequence) const
@@ -283,102 +746,284 @@ boost::dynamic_bitset<> LoadingChecker::MakeBitset(size_t size, const Collection
     return set;
 };
 
-void LoadingChecker::AddFeasibleRoute(const Collections::IdVector& route)
+void LoadingChecker::AddFeasibleRoute(const Collections::IdVector& route, const bool isDominated)
 {
-    mFeasSequences[Parameters.LoadingProblem.LoadingFlags].insert(route);
-    mCompleteFeasSeq.push_back(route);
+    const auto mask = Parameters.LoadingProblem.LoadingFlags;
+    const auto handle = mRouteStore.Intern(route);
+    // Only the thread that inserts the handle appends it -> no duplicates.
+    if (mFeasSequences.at(mask).Insert(handle))
+    {
+        if (!isDominated)
+        {
+            AddToSequenceIndex(mFeasSequenceIndex, route, mask);
+        }
+
+        std::lock_guard lock(mCompleteFeasSeqMutex);
+        mCompleteFeasSeq.push_back(handle);
+    }
+}
+
+void LoadingChecker::AddPackingCertificate(const Collections::IdVector& route, const std::vector<Cuboid>& packedItems)
+{
+    mPackingCertificates.Insert(mRouteStore.Intern(route), route, packedItems);
+}
+
+std::vector<std::optional<PlacementHint>> LoadingChecker::DetermineSolutionHint(const Collections::IdVector& route,
+                                                                               const std::vector<Cuboid>& items) const
+{
+    std::vector<std::optional<PlacementHint>> bestHint;
+    if (mPackingCertificates.Size() == 0 || route.empty())
+    {
+        return bestHint;
+    }
+
+    // Items of one customer are consecutive, first item of each stop.
+    std::vector<size_t> firstItemOfStop = {0};
+    for (size_t i = 1; i < items.size(); ++i)
+    {
+        if (items[i].GroupId != items[i - 1].GroupId)
+        {
+            firstItemOfStop.push_back(i);
+        }
+    }
+
+    firstItemOfStop.push_back(items.size());
+    if (firstItemOfStop.size() != route.size() + 1)
+    {
+        return bestHint;
+    }
+
+    size_t bestNumberHinted = 0;
+    std::vector<RouteHandle> evaluatedCandidates;
+    // Returns true if all items are hinted -> no further candidate is evaluated.
+    auto evaluateCandidate = [&](RouteHandle handle)
+    {
+        if (handle == RouteStore::InvalidHandle
+            || std::ranges::find(evaluatedCandidates, handle) != std::end(evaluatedCandidates))
+        {
+            return false;
+        }
+
+        evaluatedCandidates.push_back(handle);
+
+        const auto placements = mPackingCertificates.Find(handle);
+        if (placements.empty())
+        {
+            return false;
+        }
+
+        const auto relatedRoute = mRouteStore.Get(handle);
+
+        // First placement of each stop of the related route.
+        std::vector<size_t> firstPlacementOfStop(relatedRoute.size() + 1, placements.size());
+        for (size_t k = placements.size(); k-- > 0;)
+        {
+            firstPlacementOfStop[placements[k].Stop] = k;
+        }
+
+        std::vector<std::optional<PlacementHint>> hint(items.size());
+        size_t numberHinted = 0;
+        for (size_t stop = 0; stop < route.size(); ++stop)
+        {
+            const auto it = std::ranges::find(relatedRoute, route[stop]);
+            if (it == std::end(relatedRoute))
+            {
+                continue;
+            }
+
+            const auto relatedStop = static_cast<size_t>(std::distance(std::begin(relatedRoute), it));
+            const auto numberItems = firstItemOfStop[stop + 1] - firstItemOfStop[stop];
+            if (firstPlacementOfStop[relatedStop + 1] - firstPlacementOfStop[relatedStop] != numberItems)
+            {
+                continue;
+            }
+
+            for (size_t k = 0; k < numberItems; ++k)
+            {
+                const auto& placement = placements[firstPlacementOfStop[relatedStop] + k];
+                hint[firstItemOfStop[stop] + k] = PlacementHint{placement.X, placement.Y, placement.Z, placement.Rotated};
+            }
+
+            numberHinted += numberItems;
+        }
+
+        if (numberHinted > bestNumberHinted)
+        {
+            bestNumberHinted = numberHinted;
+            bestHint = std::move(hint);
+        }
+
+        return bestNumberHinted == items.size();
+    };
+
+    // Linear number of candidates, most similar first: the reversed route, the route without one customer and the
+    // last certificate of each customer.
+    auto reversedRoute = route;
+    std::ranges::reverse(reversedRoute);
+    if (evaluateCandidate(mRouteStore.Find(reversedRoute)))
+    {
+        return bestHint;
+    }
+
+    for (size_t removed = 0; removed < route.size(); ++removed)
+    {
+        auto subsequence = route;
+        subsequence.erase(std::begin(subsequence) + removed);
+        if (evaluateCandidate(mRouteStore.Find(subsequence)))
+        {
+            return bestHint;
+        }
+    }
+
+    for (const auto node: route)
+    {
+        if (evaluateCandidate(mPackingCertificates.LastCertificateOfNode(node)))
+        {
+            return bestHint;
+        }
+    }
+
+    return bestHint;
+}
+
+void LoadingChecker::AddToSequenceIndex(std::unordered_map<LoadingFlag, SequenceContainmentIndex>& indices,
+                                        const Collections::IdVector& sequence,
+                                        const LoadingFlag mask)
+{
+    if (auto it = indices.find(mask); it != indices.end())
+    {
+        it->second.Insert(sequence);
+    }
 }
 
 void LoadingChecker::AddInfeasibleSequenceEP(const Collections::IdVector& sequence)
 {
-    mEPHeurInfSequences.insert(sequence);
+    mEPHeurInfSequences.Insert(sequence);
 }
 
 bool LoadingChecker::SequenceIsInfeasibleCP(const Collections::IdVector& sequence, const LoadingFlag mask) const
 {
-    return mInfSequences.at(mask).contains(sequence);
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = RouteSetContains(mInfSequences.at(mask), sequence);
+    mCacheCounters.AddLookup(mask, CacheLookup::InfeasibleSequence, hit, start);
+
+    return hit;
 }
 
-bool LoadingChecker::SequenceIsUnknownCP(const Collections::IdVector& sequence, const LoadingFlag mask) const
+bool LoadingChecker::SequenceIsUnknownCP(const Collections::IdVector& sequence,
+                                         const LoadingFlag mask,
+                                         const double timeBudget) const
 {
-    return mUnkSequences.at(mask).contains(sequence);
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = IsUnknownWithinBudget(mUnkSequences.at(mask).Find(sequence), timeBudget);
+    mCacheCounters.AddLookup(mask, CacheLookup::UnknownSequence, hit, start);
+
+    return hit;
 }
 
 bool LoadingChecker::SequenceIsFeasible(const Collections::IdVector& sequence, const LoadingFlag mask) const
 {
-    return mFeasSequences.at(mask).contains(sequence);
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = RouteSetContains(mFeasSequences.at(mask), sequence);
+    mCacheCounters.AddLookup(mask, CacheLookup::FeasibleSequence, hit, start);
+
+    return hit;
 }
 
-bool LoadingChecker::SetIsInfeasibleCP(const boost::dynamic_bitset<>& set, const LoadingFlag mask) const
+bool LoadingChecker::SequenceIsDominatedInfeasibleCP(const Collections::IdVector& sequence,
+                                                     const LoadingFlag mask) const
 {
-    const auto& sets = mInfSets.at(mask);
-    if (!IsSet(mask, LoadingFlag::Support))
+    auto it = mInfSequenceIndex.find(mask);
+    if (it == mInfSequenceIndex.end())
     {
-        // If support is disabled, set S is infeasible when S is a superset of an infeasible set.
-        auto setComparer = [set](const boost::dynamic_bitset<>& infeasibleSet)
-        { return (set & infeasibleSet).count() == infeasibleSet.count(); };
-
-        if (std::find_if(std::begin(sets), std::end(sets), setComparer) != std::end(sets))
-        {
-            return true;
-        }
+        return false;
     }
-    else
-    {
-        // If support is enabled, only exact matching of sets can be used as adding additional items can lead to
-        // feasibility.
-        auto setComparer = [set](const boost::dynamic_bitset<>& feasibleCombination)
-        { return set == feasibleCombination; };
 
-        if (std::find_if(std::begin(sets), std::end(sets), setComparer) != std::end(sets))
-        {
-            return true;
-        }
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = it->second.ContainsSubsequenceOf(sequence);
+    mCacheCounters.AddLookup(mask, CacheLookup::InfeasibleSubsequence, hit, start);
+
+    return hit;
+}
+
+bool LoadingChecker::SequenceIsDominatedFeasible(const Collections::IdVector& sequence, const LoadingFlag mask) const
+{
+    auto it = mFeasSequenceIndex.find(mask);
+    if (it == mFeasSequenceIndex.end())
+    {
+        return false;
     }
 
-    return false;
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = it->second.ContainsSupersequenceOf(sequence);
+    mCacheCounters.AddLookup(mask, CacheLookup::FeasibleSupersequence, hit, start);
+
+    return hit;
+}
+
+bool LoadingChecker::SetIsInfeasibleCP(const boost::dynamic_bitset<>& set, const LoadingFlag mask) const
+{
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto& sets = mInfSets.at(mask);
+
+    // If support is disabled, set S is infeasible when S is a superset of an infeasible set.
+    // If support is enabled, only exact matching of sets can be used as adding additional items can lead to
+    // feasibility.
+    const auto hit = !IsSet(mask, LoadingFlag::Support) ? sets.ContainsSubsetOf(set) : sets.Contains(set);
+    mCacheCounters.AddLookup(mask, CacheLookup::InfeasibleSet, hit, start);
+
+    return hit;
 }
 
-bool LoadingChecker::SetIsUnknownCP(const boost::dynamic_bitset<>& set, const LoadingFlag mask) const
+bool LoadingChecker::SetIsUnknownCP(const boost::dynamic_bitset<>& set,
+                                    const LoadingFlag mask,
+                                    const double timeBudget) const
 {
-    const auto& sets = mUnknownSets.at(mask);
+    const auto start = LoadingCacheCounters::Clock::now();
+    const auto hit = IsUnknownWithinBudget(mUnknownSets.at(mask).Find(set), timeBudget);
+    mCacheCounters.AddLookup(mask, CacheLookup::UnknownSet, hit, start);
 
-    auto setComparer = [set](const boost::dynamic_bitset<>& feasibleCombination) { return set == feasibleCombination; };
+    return hit;
+}
 
-    if (std::find_if(std::begin(sets), std::end(sets), setComparer) != std::end(sets))
+bool LoadingChecker::IsUnknownWithinBudget(const std::optional<UnknownLoadingResult>& result,
+                                           const double timeBudget) const
+{
+    if (!result.has_value())
     {
-        return true;
+        return false;
     }
 
-    return false;
+    // Solve again only if the time limit is escalated enough to possibly prove what previous calls could not and the
+    // time invested in this route is not exhausted.
+    const auto& cacheParams = Parameters.LoadingCache;
+    const auto isEscalated = timeBudget >= cacheParams.UnknownEscalationFactor * result->TimeBudget;
+    const auto isExhausted = result->TotalTime >= cacheParams.MaxTotalTimeUnknown;
+
+    return !isEscalated || isExhausted;
+}
+
+UnknownLoadingResult LoadingChecker::AddUnknownCall(UnknownLoadingResult result, const double timeBudget)
+{
+    // A call with unknown result hit the time limit -> whole budget is spent.
+    result.TimeBudget = std::max(result.TimeBudget, timeBudget);
+    result.TotalTime += timeBudget;
+    result.Calls++;
+
+    return result;
 }
 
 bool LoadingChecker::SetIsFeasibleCP(const boost::dynamic_bitset<>& set, const LoadingFlag mask) const
 {
+    const auto start = LoadingCacheCounters::Clock::now();
     const auto& sets = mFeasibleSets.at(mask);
-    if (!IsSet(mask, LoadingFlag::Support))
-    {
-        // If support is disabled, set S is feasible when S is a subset of a feasible set.
-        auto setComparer = [set](const boost::dynamic_bitset<>& feasibleSet)
-        { return (set & feasibleSet).count() == set.count(); };
 
-        if (std::find_if(std::begin(sets), std::end(sets), setComparer) != std::end(sets))
-        {
-            return true;
-        }
-    }
-    else
-    {
-        // If support is enabled, only exact matching of sets can be used as removing items can lead to infeasibility.
-        auto setComparer = [set](const boost::dynamic_bitset<>& feasibleCombi) { return set == feasibleCombi; };
+    // If support is disabled, set S is feasible when S is a subset of a feasible set.
+    // If support is enabled, only exact matching of sets can be used as removing items can lead to infeasibility.
+    const auto hit = !IsSet(mask, LoadingFlag::Support) ? sets.ContainsSupersetOf(set) : sets.Contains(set);
+    mCacheCounters.AddLookup(mask, CacheLookup::FeasibleSet, hit, start);
 
-        if (std::find_if(std::begin(sets), std::end(sets), setComparer) != std::end(sets))
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return hit;
 }
 
 LoadingFlag LoadingChecker::BuildMask(PackingType type) const
@@ -401,7 +1046,8 @@ LoadingFlag LoadingChecker::BuildMask(PackingType type) const
 LoadingStatus LoadingChecker::GetPrecheckStatusCP(const Collections::IdVector& sequence,
                                                   const boost::dynamic_bitset<>& set,
                                                   const LoadingFlag mask,
-                                                  const bool isCallTypeExact)
+                                                  const bool isCallTypeExact,
+                                                  const double timeBudget)
 {
     if (IsSet(mask, LoadingFlag::Sequence))
     {
@@ -417,9 +1063,26 @@ LoadingStatus LoadingChecker::GetPrecheckStatusCP(const Collections::IdVector& s
             return LoadingStatus::FeasOpt;
         }
 
-        if (!isCallTypeExact && SequenceIsUnknownCP(sequence, mask))
+        // If support is disabled, a sequence is infeasible when it contains an infeasible sequence as subsequence and
+        // feasible when it is a subsequence of a feasible sequence, as removing stops keeps the order of the others.
+        if (SequenceIsDominatedInfeasibleCP(sequence, mask))
+        {
+            return LoadingStatus::Infeasible;
+        }
+
+        if (SequenceIsDominatedFeasible(sequence, mask))
         {
-            ////std::cout << "Sequence already stored as unknown (CP)." << "\n";
+            if (mask == Parameters.LoadingProblem.LoadingFlags)
+            {
+                AddFeasibleRoute(sequence, true);
+            }
+
+            return LoadingStatus::FeasOpt;
+        }
+
+        if (!isCallTypeExact && SequenceIsUnknownCP(sequence, mask, timeBudget))
+        {
+            ////std::cout << "Sequence already stored as unknown (CP) with sufficient time limit." << "\n";
             return LoadingStatus::Unknown;
         }
     }
@@ -442,9 +1105,9 @@ LoadingStatus LoadingChecker::GetPrecheckStatusCP(const Collections::IdVector& s
             return LoadingStatus::FeasOpt;
         }
 
-        if (!isCallTypeExact && SetIsUnknownCP(set, mask))
+        if (!isCallTypeExact && SetIsUnknownCP(set, mask, timeBudget))
         {
-            ////std::cout << "Set already stored as unknown (CP)." << "\n";
+            ////std::cout << "Set already stored as unknown (CP) with sufficient time limit." << "\n";
             return LoadingStatus::Unknown;
         }
     }
@@ -455,15 +1118,21 @@ LoadingStatus LoadingChecker::GetPrecheckStatusCP(const Collections::IdVector& s
 void LoadingChecker::AddStatus(const Collections::IdVector& sequence,
                                const boost::dynamic_bitset<>& set,
                                const LoadingFlag mask,
-                               const LoadingStatus status)
+                               const LoadingStatus status,
+                               const double timeBudget)
 {
+    if (mPersistentCache != nullptr)
+    {
+        RecordPersistentEntry(sequence, set, mask, status, timeBudget);
+    }
+
     // Add to feasible sequences although lifo might be disabled; needed for SP heuristic.
     if (status == LoadingStatus::FeasOpt && mask == Parameters.LoadingProblem.LoadingFlags)
     {
         AddFeasibleRoute(sequence);
         if (!IsSet(mask, LoadingFlag::Lifo))
         {
-            mFeasibleSets[mask].push_back(set);
+            mFeasibleSets.at(mask).Insert(set);
         }
 
         return;
@@ -476,17 +1145,27 @@ void LoadingChecker::AddStatus(const Collections::IdVector& sequence,
         {
             case LoadingStatus::FeasOpt:
             {
-                mFeasSequences[mask].insert(sequence);
+                if (mFeasSequences.at(mask).Insert(mRouteStore.Intern(sequence)))
+                {
+                    AddToSequenceIndex(mFeasSequenceIndex, sequence, mask);
+                }
+
                 return;
             }
             case LoadingStatus::Infeasible:
             {
-                mInfSequences[mask].insert(sequence);
+                if (mInfSequences.at(mask).Insert(mRouteStore.Intern(sequence)))
+                {
+                    AddToSequenceIndex(mInfSequenceIndex, sequence, mask);
+                }
+
                 return;
             }
             case LoadingStatus::Unknown:
             {
-                mUnkSequences[mask].insert(sequence);
+                mUnkSequences.at(mask).Update(sequence,
+                                              [timeBudget](const UnknownLoadingResult& result)
+                                              { return AddUnknownCall(result, timeBudget); });
                 return;
             }
             default:
@@ -500,17 +1179,18 @@ void LoadingChecker::AddStatus(const Collections::IdVector& sequence,
         {
             case LoadingStatus::FeasOpt:
             {
-                mFeasibleSets[mask].push_back(set);
+                mFeasibleSets.at(mask).Insert(set);
                 return;
             }
             case LoadingStatus::Infeasible:
             {
-                mInfSets[mask].push_back(set);
+                mInfSets.at(mask).Insert(set);
                 return;
             }
             case LoadingStatus::Unknown:
             {
-                mUnknownSets[mask].push_back(set);
+                mUnknownSets.at(mask).Update(
+                    set, [timeBudget](const UnknownLoadingResult& result) { return AddUnknownCall(result, timeBudget); });
                 return;
             }
             default:
@@ -519,4 +1199,62 @@ void LoadingChecker::AddStatus(const Collections::IdVector& sequence,
     }
 }
 
-}
\ No newline at end of file
+size_t LoadingChecker::EnablePersistentCache(const std::string& filePath, uint64_t key)
+{
+    auto persistentCache = std::make_unique<PersistentLoadingCache>(filePath, key);
+
+    auto entries = persistentCache->Load();
+    for (const auto& entry: entries)
+    {
+        if (!mFeasSequences.contains(entry.Mask))
+        {
+            // Mask is not used with the current loading flags.
+            continue;
+        }
+
+        auto set = entry.SetSize > 0 ? MakeBitset(entry.SetSize, entry.Sequence) : boost::dynamic_bitset<>();
+        AddStatus(entry.Sequence, set, entry.Mask, entry.Status, entry.TimeBudget);
+    }
+
+    // Enable recording after import to not write imported results again.
+    mPersistentCache = std::move(persistentCache);
+
+    return entries.size();
+}
+
+void LoadingChecker::SavePersistentCache()
+{
+    if (mPersistentCache == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard lock(mNewPersistentEntriesMutex);
+    mPersistentCache->Append(mNewPersistentEntries);
+    mNewPersistentEntries.clear();
+}
+
+void LoadingChecker::RecordPersistentEntry(const Collections::IdVector& sequence,
+                                           const boost::dynamic_bitset<>& set,
+                                           const LoadingFlag mask,
+                                           const LoadingStatus status,
+                                           const double timeBudget)
+{
+    // Sets are restored from the sequence. Skip the rare case where the set does not consist of the sequence nodes.
+    if (set.size() > 0 && (set.count() != sequence.size() || set != MakeBitset(set.size(), sequence)))
+    {
+        return;
+    }
+
+    PersistentLoadingEntry entry;
+    entry.Mask = mask;
+    entry.Status = status;
+    entry.SetSize = set.size();
+    entry.TimeBudget = timeBudget;
+    entry.Sequence = sequence;
+
+    std::lock_guard lock(mNewPersistentEntriesMutex);
+    mNewPersistentEntries.push_back(std::move(entry));
+}
+
+}
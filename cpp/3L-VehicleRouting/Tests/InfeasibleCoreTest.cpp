@@ -0,0 +1,110 @@
+#include "TestHelper.h"
+
+#include "LoadingChecker.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace ContainerLoading;
+using namespace ContainerLoading::Model;
+
+namespace
+{
+ContainerLoadingParams CreateParameters(LoadingProblemParams::VariantType variant)
+{
+    ContainerLoadingParams parameters;
+    parameters.LoadingProblem.Variant = variant;
+    parameters.LoadingProblem.SetFlags();
+    parameters.CPSolver.Threads = 1;
+
+    return parameters;
+}
+
+Group CreateNode(size_t id, int dx, int dy, int dz, Fragility fragility = Fragility::None)
+{
+    auto item = Cuboid(id, id, dx, dy, dz, true, fragility, 0, 1.0);
+    auto volume = static_cast<double>(dx) * dy * dz;
+    return Group(id, id, 0.0, 0.0, 1.0, volume, static_cast<double>(dx) * dy, {item});
+}
+
+/// Node 0 is the depot. Nodes 1 and 2 each fill 60 % of the height of the container, node 3 has a small item -> every
+/// infeasible subset of {1, 2, 3} contains nodes 1 and 2.
+std::vector<Group> CreateNodes()
+{
+    return {Group(0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, {}),
+            CreateNode(1, 10, 10, 6),
+            CreateNode(2, 10, 10, 6),
+            CreateNode(3, 1, 1, 1)};
+}
+
+/// Each node fills half of the container, nodes 1 and 2 are fragile -> any two nodes can be stacked, only all three
+/// are infeasible. Item 3 can neither be placed below a core item (it would support it) nor on top of the fragile item
+/// on the floor, so the core {1, 2} is found if the constraints of item 3 are not relaxed together with its customer.
+std::vector<Group> CreateFragileNodes()
+{
+    return {Group(0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, {}),
+            CreateNode(1, 10, 10, 5, Fragility::Fragile),
+            CreateNode(2, 10, 10, 5, Fragility::Fragile),
+            CreateNode(3, 10, 10, 5)};
+}
+
+void CheckCore(LoadingProblemParams::VariantType variant,
+               std::vector<Group> nodes,
+               const Collections::IdVector& route,
+               bool expectInfeasible,
+               const Collections::IdVector& expectedNodes)
+{
+    const auto parameters = CreateParameters(variant);
+    const auto container = Container(10, 10, 10, 100.0);
+
+    LoadingChecker loadingChecker(parameters);
+    const auto set = loadingChecker.MakeBitset(nodes.size(), route);
+    const auto items = loadingChecker.SelectItems(route, nodes, false);
+
+    const auto core = loadingChecker.DetermineInfeasibleCore(
+        PackingType::Complete, container, set, route, items, std::numeric_limits<double>::max());
+
+    if (!expectInfeasible)
+    {
+        Tests::Check(core.empty(), "core of a feasible route must be empty");
+        return;
+    }
+
+    Tests::Check(!core.empty(), "core of an infeasible route must not be empty");
+
+    // The core keeps the route order, a wrong group id -> stop mapping yields other stops or another order.
+    auto position = route.begin();
+    for (const auto node: core)
+    {
+        position = std::find(position, route.end(), node);
+        Tests::Check(position != route.end(), "core must be a subsequence of the route");
+    }
+
+    const auto containsNode = [&core](size_t node) { return std::ranges::find(core, node) != core.end(); };
+    Tests::Check(std::ranges::all_of(expectedNodes, containsNode),
+                 "core must contain the nodes of every infeasible subset");
+
+    // Solved without any cached result of the route.
+    LoadingChecker independentChecker(parameters);
+    const auto coreSet = independentChecker.MakeBitset(nodes.size(), core);
+    const auto coreItems = independentChecker.SelectItems(core, nodes, false);
+    const auto status = independentChecker.ConstraintProgrammingSolver(
+        PackingType::Complete, container, coreSet, core, coreItems, true, std::numeric_limits<double>::max());
+    Tests::Check(status == LoadingStatus::Infeasible, "core must be infeasible on its own");
+}
+
+}
+
+int main()
+{
+    return Tests::Run("InfeasibleCoreTest",
+                      []()
+                      {
+                          using enum LoadingProblemParams::VariantType;
+                          CheckCore(LoadingOnly, CreateNodes(), {3, 1, 2}, true, {1, 2});
+                          CheckCore(LoadingOnly, CreateNodes(), {1, 3, 2}, true, {1, 2});
+                          CheckCore(LoadingOnly, CreateNodes(), {1, 3}, false, {});
+                          CheckCore(NoLifo, CreateFragileNodes(), {1, 2, 3}, true, {1, 2, 3});
+                          CheckCore(NoLifo, CreateFragileNodes(), {3, 2, 1}, true, {1, 2, 3});
+                      });
+}
@@ -0,0 +1,322 @@
+#include "TestHelper.h"
+
+#include "LoadingChecker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <set>
+#include <thread>
+
+using namespace ContainerLoading;
+using namespace ContainerLoading::Model;
+
+namespace
+{
+constexpr size_t NumberThreads = 8;
+constexpr size_t NumberNodes = 30;
+constexpr size_t NumberRoutes = 300;
+/// Node with an item larger than the container -> routes with this node are infeasible by the item dimension bound.
+constexpr size_t OversizedNode = 1;
+
+ContainerLoadingParams CreateParameters()
+{
+    ContainerLoadingParams parameters;
+    parameters.LoadingProblem.Variant = LoadingProblemParams::VariantType::AllConstraints;
+    parameters.LoadingProblem.SetFlags();
+    parameters.CPSolver.Threads = 1;
+
+    return parameters;
+}
+
+std::vector<Group> CreateNodes()
+{
+    std::vector<Group> nodes;
+    nodes.emplace_back(0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, std::vector<Cuboid>{});
+    for (size_t id = 1; id < NumberNodes; ++id)
+    {
+        const auto length = id == OversizedNode ? 11 : 1;
+        auto item = Cuboid(id, id, length, length, length, true, Fragility::None, 0, 1.0);
+        nodes.emplace_back(id, id, 0.0, 0.0, 1.0, 1.0, 1.0, std::vector<Cuboid>{item});
+    }
+
+    return nodes;
+}
+
+/// Distinct routes of 2 to 6 customers, infeasible routes contain OversizedNode.
+Collections::SequenceVector CreateRoutes(bool infeasible, uint32_t seed)
+{
+    std::mt19937 generator(seed);
+    std::vector<size_t> customers(NumberNodes - 2);
+    std::iota(customers.begin(), customers.end(), OversizedNode + 1);
+
+    std::set<Collections::IdVector> routes;
+    while (routes.size() < NumberRoutes)
+    {
+        std::ranges::shuffle(customers, generator);
+        const auto length = std::uniform_int_distribution<size_t>(2, 6)(generator);
+        auto route = Collections::IdVector(customers.begin(), customers.begin() + length);
+        if (infeasible)
+        {
+            const auto position = std::uniform_int_distribution<size_t>(0, route.size())(generator);
+            route.insert(route.begin() + position, OversizedNode);
+        }
+
+        routes.insert(route);
+    }
+
+    return {routes.begin(), routes.end()};
+}
+
+size_t NumberBoundChecks(const LoadingChecker& loadingChecker)
+{
+    size_t checks = 0;
+    for (const auto& bound: loadingChecker.GetCacheCounters().Bounds())
+    {
+        checks += bound.Hits;
+    }
+
+    return checks;
+}
+
+size_t NumberSolves(const LoadingChecker& loadingChecker)
+{
+    size_t solves = 0;
+    for (const auto& solve: loadingChecker.GetCacheCounters().Solves())
+    {
+        solves += solve.Calls;
+    }
+
+    return solves;
+}
+
+/// Runs work(threadIndex) on NumberThreads threads, failed checks are rethrown after all threads have finished.
+template <typename Work>
+void RunConcurrently(Work work)
+{
+    std::vector<std::exception_ptr> exceptions(NumberThreads);
+    std::vector<std::thread> threads;
+    threads.reserve(NumberThreads);
+    for (size_t t = 0; t < NumberThreads; ++t)
+    {
+        threads.emplace_back(
+            [&work, &exceptions, t]()
+            {
+                try
+                {
+                    work(t);
+                }
+                catch (...)
+                {
+                    exceptions[t] = std::current_exception();
+                }
+            });
+    }
+
+    for (auto& thread: threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& exception: exceptions)
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+/// Equal routes interned concurrently get the same handle, distinct routes distinct handles.
+void TestRouteStore()
+{
+    const auto routes = CreateRoutes(false, 1);
+
+    RouteStore routeStore;
+    std::vector<std::vector<RouteHandle>> handles(NumberThreads, std::vector<RouteHandle>(routes.size()));
+    RunConcurrently(
+        [&routes, &routeStore, &handles](size_t t)
+        {
+            std::vector<size_t> order(routes.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::shuffle(order, std::mt19937(static_cast<uint32_t>(t)));
+
+            for (const auto r: order)
+            {
+                handles[t][r] = routeStore.Intern(routes[r]);
+                Tests::Check(routeStore.Find(routes[r]) == handles[t][r], "interned route must be found");
+            }
+        });
+
+    Tests::Check(routeStore.Size() == routes.size(), "route store must contain each route once");
+
+    std::set<RouteHandle> distinctHandles;
+    for (size_t r = 0; r < routes.size(); ++r)
+    {
+        for (size_t t = 1; t < NumberThreads; ++t)
+        {
+            Tests::Check(handles[t][r] == handles[0][r], "equal routes must get equal handles");
+        }
+
+        Tests::Check(routeStore.Get(handles[0][r]) == routes[r], "handle must resolve to its route");
+        distinctHandles.insert(handles[0][r]);
+    }
+
+    Tests::Check(distinctHandles.size() == routes.size(), "distinct routes must get distinct handles");
+}
+
+/// Feasible routes are added from outside and infeasible routes are stored by AddStatus after the item dimension
+/// bound, while one reader polls GetFeasibleRoutes. Neither needs a CP solve.
+void TestLoadingChecker()
+{
+    const auto parameters = CreateParameters();
+    const auto container = Container(10, 10, 10, std::numeric_limits<double>::max());
+    const auto nodes = CreateNodes();
+    const auto feasibleRoutes = CreateRoutes(false, 2);
+    const auto infeasibleRoutes = CreateRoutes(true, 3);
+
+    LoadingChecker loadingChecker(parameters);
+
+    auto check = [&loadingChecker, &container](const Collections::IdVector& route, std::vector<Group>& threadNodes)
+    {
+        const auto set = loadingChecker.MakeBitset(NumberNodes, route);
+        const auto items = loadingChecker.SelectItems(route, threadNodes, false);
+        return loadingChecker.ConstraintProgrammingSolver(PackingType::Complete, container, set, route, items, true);
+    };
+
+    std::atomic<size_t> finishedWriters = 0;
+    Collections::SequenceVector polledRoutes;
+    RunConcurrently(
+        [&](size_t t)
+        {
+            if (t == 0)
+            {
+                // Feasible routes keep their index -> each poll appends to the routes seen before.
+                auto lastNumberRoutes = size_t{0};
+                while (finishedWriters.load() < NumberThreads - 1)
+                {
+                    for (auto& route: loadingChecker.GetFeasibleRoutes(polledRoutes.size()))
+                    {
+                        polledRoutes.push_back(std::move(route));
+                    }
+
+                    const auto numberRoutes = loadingChecker.GetNumberOfFeasibleRoutes();
+                    Tests::Check(numberRoutes >= lastNumberRoutes, "number of feasible routes must not decrease");
+                    lastNumberRoutes = numberRoutes;
+                }
+
+                return;
+            }
+
+            // Also counted if a check fails, the reader stops after all writers.
+            struct FinishedWriter
+            {
+                std::atomic<size_t>& Counter;
+                ~FinishedWriter() { Counter++; }
+            } finishedWriter{finishedWriters};
+
+            // SelectItems sets the group ids of the items of the nodes.
+            auto threadNodes = nodes;
+            std::mt19937 generator(static_cast<uint32_t>(t));
+            std::vector<size_t> order(feasibleRoutes.size() + infeasibleRoutes.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::shuffle(order, generator);
+
+            for (const auto r: order)
+            {
+                if (r < feasibleRoutes.size())
+                {
+                    const auto& route = feasibleRoutes[r];
+                    loadingChecker.AddFeasibleSequenceFromOutside(route);
+                    Tests::Check(loadingChecker.RouteIsInFeasSequences(route), "added route must be feasible");
+                    Tests::Check(check(route, threadNodes) == LoadingStatus::FeasOpt, "added route must be cached");
+                    continue;
+                }
+
+                const auto& route = infeasibleRoutes[r - feasibleRoutes.size()];
+                Tests::Check(check(route, threadNodes) == LoadingStatus::Infeasible, "route must be infeasible");
+                Tests::Check(check(route, threadNodes) == LoadingStatus::Infeasible, "route must stay infeasible");
+            }
+        });
+
+    Tests::Check(NumberSolves(loadingChecker) == 0, "no route must be solved by CP");
+
+    const auto allRoutes = loadingChecker.GetFeasibleRoutes();
+    Tests::Check(allRoutes.size() == feasibleRoutes.size(), "each feasible route must be stored once");
+    Tests::Check(std::set<Collections::IdVector>(allRoutes.begin(), allRoutes.end())
+                     == std::set<Collections::IdVector>(feasibleRoutes.begin(), feasibleRoutes.end()),
+                 "stored feasible routes must equal the added routes");
+
+    for (auto& route: loadingChecker.GetFeasibleRoutes(polledRoutes.size()))
+    {
+        polledRoutes.push_back(std::move(route));
+    }
+    Tests::Check(polledRoutes == allRoutes, "polled routes must be a prefix of the feasible routes in each poll");
+
+    // Each bound check is followed by AddStatus -> all infeasible routes are cached now.
+    auto threadNodes = nodes;
+    const auto numberBoundChecks = NumberBoundChecks(loadingChecker);
+    for (const auto& route: infeasibleRoutes)
+    {
+        Tests::Check(check(route, threadNodes) == LoadingStatus::Infeasible, "route must be infeasible");
+    }
+    Tests::Check(NumberBoundChecks(loadingChecker) == numberBoundChecks, "infeasible routes must be cached");
+}
+
+/// Feasible routes are solved by CP concurrently, all threads check the same routes in different orders -> the CP model
+/// of a route is shared. A route may be solved by several threads before its result is cached, but stored once.
+void TestConcurrentSolves()
+{
+    constexpr size_t NumberSolvedRoutes = 20;
+
+    const auto parameters = CreateParameters();
+    const auto container = Container(10, 10, 10, std::numeric_limits<double>::max());
+    const auto nodes = CreateNodes();
+    auto routes = CreateRoutes(false, 4);
+    routes.resize(NumberSolvedRoutes);
+
+    LoadingChecker loadingChecker(parameters);
+    RunConcurrently(
+        [&](size_t t)
+        {
+            auto threadNodes = nodes;
+            std::vector<size_t> order(routes.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::shuffle(order, std::mt19937(static_cast<uint32_t>(t)));
+
+            for (const auto r: order)
+            {
+                const auto& route = routes[r];
+                const auto set = loadingChecker.MakeBitset(NumberNodes, route);
+                const auto items = loadingChecker.SelectItems(route, threadNodes, false);
+                const auto status = loadingChecker.ConstraintProgrammingSolver(
+                    PackingType::Complete, container, set, route, items, true);
+                Tests::Check(status == LoadingStatus::FeasOpt, "route must be feasible");
+            }
+        });
+
+    const auto numberSolves = NumberSolves(loadingChecker);
+    Tests::Check(numberSolves >= routes.size() && numberSolves <= routes.size() * NumberThreads,
+                 "each route must be solved at least once and at most once per thread");
+
+    const auto allRoutes = loadingChecker.GetFeasibleRoutes();
+    Tests::Check(std::set<Collections::IdVector>(allRoutes.begin(), allRoutes.end())
+                     == std::set<Collections::IdVector>(routes.begin(), routes.end()),
+                 "stored feasible routes must equal the solved routes");
+    Tests::Check(allRoutes.size() == routes.size(), "each solved route must be stored once");
+}
+
+}
+
+int main()
+{
+    return Tests::Run("LoadingCheckerConcurrencyTest",
+                      []()
+                      {
+                          TestRouteStore();
+                          TestLoadingChecker();
+                          TestConcurrentSolves();
+                      });
+}
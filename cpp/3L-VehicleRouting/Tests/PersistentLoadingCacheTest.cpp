@@ -0,0 +1,167 @@
+#include "TestHelper.h"
+
+#include "Helper/PersistentLoadingCache.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ContainerLoading;
+
+namespace
+{
+/// Size of the file identifier and of a record header.
+constexpr size_t IdentifierSize = 8;
+constexpr size_t HeaderSize = 32;
+
+std::vector<PersistentLoadingEntry> CreateEntries()
+{
+    std::vector<PersistentLoadingEntry> entries(3);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        entries[i].Mask = LoadingFlag::Complete;
+        entries[i].Status = LoadingStatus::Infeasible;
+        entries[i].SetSize = 10;
+        entries[i].TimeBudget = static_cast<double>(i);
+        entries[i].Sequence = {1, 2, 3 + i};
+    }
+
+    return entries;
+}
+
+void TestCorruptRecords(const std::string& filePath)
+{
+    std::filesystem::remove(filePath);
+
+    const auto entries = CreateEntries();
+    PersistentLoadingCache cache(filePath, 42);
+    PersistentLoadingCache otherCache(filePath, 7);
+    cache.Append(entries);
+    otherCache.Append(entries);
+    Tests::Check(cache.Load().size() == entries.size(), "records of the key must be loaded");
+    Tests::Check(otherCache.Load().size() == entries.size(), "records of the other key must be loaded");
+
+    // Partial record of an aborted run.
+    const auto intactSize = std::filesystem::file_size(filePath);
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::app);
+        file.write("partial", 7);
+    }
+    Tests::Check(cache.Load().size() == entries.size(), "partial record must be ignored");
+
+    cache.Append({entries[0]});
+    Tests::Check(std::filesystem::file_size(filePath) == intactSize + HeaderSize + 3 * sizeof(uint16_t),
+                 "partial record must be cut off before appending");
+    Tests::Check(cache.Load().size() == entries.size() + 1, "appended record must be loaded");
+
+    // A flipped node id of the second record invalidates its checksum -> all following records are dropped.
+    {
+        std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(IdentifierSize + 2 * HeaderSize + 3 * sizeof(uint16_t)));
+        file.put(static_cast<char>(0x7f));
+    }
+    Tests::Check(cache.Load().size() == 1, "reading must stop at a corrupt record");
+}
+
+void TestInvalidValues(const std::string& filePath)
+{
+    std::filesystem::remove(filePath);
+
+    auto entries = CreateEntries();
+    entries[1].Status = static_cast<LoadingStatus>(9);
+    entries[2].Sequence = {1, 20};
+
+    PersistentLoadingCache cache(filePath, 42);
+    cache.Append(entries);
+    Tests::Check(cache.Load().size() == 1, "records with unknown status or nodes outside the set must be skipped");
+}
+
+constexpr size_t ProcessCount = 8;
+constexpr size_t AppendsPerProcess = 200;
+
+/// Child process of TestConcurrentProcesses, appends and loads records one by one.
+int AppendRecords(const std::string& filePath, size_t processId)
+{
+    PersistentLoadingCache cache(filePath, 42);
+    for (size_t i = 0; i < AppendsPerProcess; ++i)
+    {
+        PersistentLoadingEntry entry;
+        entry.Mask = LoadingFlag::Complete;
+        entry.Status = LoadingStatus::Infeasible;
+        entry.SetSize = ProcessCount;
+        entry.TimeBudget = static_cast<double>(i);
+        entry.Sequence = {processId};
+        cache.Append({entry});
+
+        // Interleaved reads, a sharable lock must not let an append in.
+        if (i % 10 == 0)
+        {
+            (void)cache.Load();
+        }
+    }
+
+    return 0;
+}
+
+/// Several processes append to the same file, no record may be lost or corrupted.
+void TestConcurrentProcesses(const std::string& executable, const std::string& filePath)
+{
+    std::filesystem::remove(filePath);
+
+    std::vector<int> exitCodes(ProcessCount, -1);
+    std::vector<std::thread> processes;
+    for (size_t p = 0; p < ProcessCount; ++p)
+    {
+        const auto command = "\"" + executable + "\" --append \"" + filePath + "\" " + std::to_string(p);
+        processes.emplace_back([command, &exitCode = exitCodes[p]]() { exitCode = std::system(command.c_str()); });
+    }
+
+    for (auto& process: processes)
+    {
+        process.join();
+    }
+
+    for (const auto exitCode: exitCodes)
+    {
+        Tests::Check(exitCode == 0, "appending process failed");
+    }
+
+    std::vector<size_t> recordsPerProcess(ProcessCount, 0);
+    for (const auto& entry: PersistentLoadingCache(filePath, 42).Load())
+    {
+        recordsPerProcess[entry.Sequence.front()]++;
+    }
+
+    for (const auto records: recordsPerProcess)
+    {
+        Tests::Check(records == AppendsPerProcess, "records of concurrent processes must not be lost");
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 4 && std::string(argv[1]) == "--append")
+    {
+        return AppendRecords(argv[2], std::stoul(argv[3]));
+    }
+
+    const auto filePath = (std::filesystem::temp_directory_path() / "PersistentLoadingCacheTest.bin").string();
+
+    const auto result = Tests::Run("PersistentLoadingCacheTest",
+                                   [&filePath, executable = std::string(argv[0])]()
+                                   {
+                                       TestCorruptRecords(filePath);
+                                       TestInvalidValues(filePath);
+                                       TestConcurrentProcesses(executable, filePath);
+                                   });
+
+    std::filesystem::remove(filePath);
+    std::filesystem::remove(filePath + ".lock");
+
+    return result;
+}
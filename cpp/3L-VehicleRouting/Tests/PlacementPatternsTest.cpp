@@ -0,0 +1,199 @@
+#include "TestHelper.h"
+
+#include "Algorithms/PlacementPoints.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace ContainerLoading;
+using namespace ContainerLoading::Model;
+
+namespace
+{
+using Algorithms::PlacementPattern;
+using Algorithms::PlacementPointGenerator;
+
+/// Placement patterns by key "<instance> <pattern type> <axis> <index>".
+using PatternMap = std::map<std::string, boost::dynamic_bitset<>>;
+
+struct ItemType
+{
+    int Dx;
+    int Dy;
+    int Dz;
+    bool EnableHorizontalRotation;
+    size_t Count;
+};
+
+struct Instance
+{
+    Container Vehicle;
+    std::vector<Cuboid> Items;
+};
+
+Instance CreateInstance(const Container& vehicle, const std::vector<ItemType>& itemTypes)
+{
+    Instance instance{vehicle, {}};
+    for (const auto& type: itemTypes)
+    {
+        for (size_t k = 0; k < type.Count; ++k)
+        {
+            const auto id = instance.Items.size();
+            instance.Items.emplace_back(
+                id, id, type.Dx, type.Dy, type.Dz, type.EnableHorizontalRotation, Fragility::None, 0, 1.0);
+        }
+    }
+
+    return instance;
+}
+
+/// Containers wider than one block of the bitsets, identical items (deduplication) and rotatable items.
+std::vector<Instance> CreateInstances()
+{
+    return {CreateInstance(Container(60, 25, 30, 1000.0), {{12, 8, 10, true, 3}, {7, 11, 9, false, 2}}),
+            CreateInstance(Container(250, 100, 90, 1000.0),
+                           {{31, 22, 17, true, 4}, {45, 19, 28, false, 3}, {23, 23, 23, true, 2}}),
+            CreateInstance(Container(131, 67, 70, 1000.0),
+                           {{14, 9, 12, false, 5}, {20, 15, 7, true, 3}, {9, 30, 25, true, 2}, {40, 12, 16, false, 2}}),
+            CreateInstance(Container(200, 80, 80, 1000.0), {{17, 13, 11, true, 10}}),
+            CreateInstance(Container(97, 41, 53, 1000.0),
+                           {{11, 7, 5, true, 1},
+                            {13, 9, 14, false, 1},
+                            {29, 17, 21, true, 1},
+                            {8, 33, 12, false, 1},
+                            {41, 6, 19, true, 1},
+                            {5, 5, 47, false, 1}})};
+}
+
+std::string AxisName(Axis axis)
+{
+    switch (axis)
+    {
+        case Axis::X:
+            return "X";
+        case Axis::Y:
+            return "Y";
+        case Axis::Z:
+            return "Z";
+        default:
+            return "None";
+    }
+}
+
+std::string Key(size_t instance, const std::string& patternType, Axis axis, size_t index)
+{
+    return std::to_string(instance) + " " + patternType + " " + AxisName(axis) + " " + std::to_string(index);
+}
+
+/// Regular normal patterns of the container with reduced height, as used for the item-specific patterns, and
+/// item-specific patterns of all items, which cover the subset sums of the other items and the deduplication.
+PatternMap DeterminePatterns(const std::vector<Instance>& instances)
+{
+    PatternMap patterns;
+    for (size_t n = 0; n < instances.size(); ++n)
+    {
+        auto items = instances[n].Items;
+        std::vector<Cuboid*> itemPointers;
+        for (auto& item: items)
+        {
+            itemPointers.push_back(&item);
+        }
+
+        const auto& vehicle = instances[n].Vehicle;
+        const auto reductions = std::vector<int>{0, vehicle.Dz / 3};
+        for (size_t r = 0; r < reductions.size(); ++r)
+        {
+            const auto reduction = reductions[r];
+            patterns[Key(n, "Container", Axis::X, r)] = PlacementPointGenerator::DetermineRegularNormalPatternsX(
+                vehicle.Dx - reduction, vehicle.Dx, itemPointers);
+            patterns[Key(n, "Container", Axis::Y, r)] = PlacementPointGenerator::DetermineRegularNormalPatternsY(
+                vehicle.Dy - reduction, vehicle.Dy, itemPointers);
+            patterns[Key(n, "Container", Axis::Z, r)] = PlacementPointGenerator::DetermineRegularNormalPatternsZ(
+                vehicle.Dz - reduction, vehicle.Dz, itemPointers);
+        }
+
+        for (const auto& [patternType, name]: {std::pair{PlacementPattern::RegularNormalPatterns, "RegularNormal"},
+                                               std::pair{PlacementPattern::MeetInTheMiddle, "MeetInTheMiddle"}})
+        {
+            for (const auto axis: {Axis::X, Axis::Y, Axis::Z})
+            {
+                auto instanceItems = instances[n].Items;
+                const auto itemPatterns =
+                    PlacementPointGenerator::GeneratePlacementPatterns(vehicle, instanceItems, patternType, axis);
+                for (size_t i = 0; i < itemPatterns.size(); ++i)
+                {
+                    patterns[Key(n, name, axis, i)] = itemPatterns[i];
+                }
+            }
+        }
+    }
+
+    return patterns;
+}
+
+/// Bitset from "<size> <hex digits>", the first digit holds the lowest four bits.
+boost::dynamic_bitset<> ParseBitset(std::istream& stream)
+{
+    size_t size = 0;
+    std::string digits;
+    stream >> size >> digits;
+
+    boost::dynamic_bitset<> bitset(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        const auto digit = std::stoi(std::string(1, digits.at(i / 4)), nullptr, 16);
+        bitset[i] = ((digit >> (i % 4)) & 1) == 1;
+    }
+
+    return bitset;
+}
+
+/// Golden patterns, one line "<key> <size> <hex digits>" per bitset.
+PatternMap ReadPatterns(const std::string& filePath)
+{
+    std::ifstream file(filePath);
+    Tests::Check(file.is_open(), "file " + filePath + " cannot be opened");
+
+    PatternMap patterns;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+
+        std::istringstream stream(line);
+        std::string instance;
+        std::string patternType;
+        std::string axis;
+        std::string index;
+        stream >> instance >> patternType >> axis >> index;
+        patterns[instance + " " + patternType + " " + axis + " " + index] = ParseBitset(stream);
+    }
+
+    return patterns;
+}
+
+}
+
+/// Compares the placement patterns bit by bit with the patterns of the implementation before the word-parallel subset
+/// sums and the deduplication of identical items on fixed instances.
+int main()
+{
+    return Tests::Run("PlacementPatternsTest",
+                      []()
+                      {
+                          const auto expected = ReadPatterns(PLACEMENT_PATTERNS_FILE);
+                          const auto actual = DeterminePatterns(CreateInstances());
+
+                          Tests::Check(actual.size() == expected.size(), "number of placement patterns differs");
+                          for (const auto& [key, bitset]: expected)
+                          {
+                              const auto pattern = actual.find(key);
+                              Tests::Check(pattern != actual.end() && pattern->second == bitset,
+                                           "placement patterns " + key + " differ");
+                          }
+                      });
+}
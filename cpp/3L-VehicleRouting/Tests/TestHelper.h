@@ -0,0 +1,36 @@
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace Tests
+{
+/// Aborts the test with message, caught in main of each test.
+inline void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+    {
+        throw std::runtime_error(message);
+    }
+}
+
+/// Runs test and converts a failed check into the exit code of the test.
+template <typename TestFunction>
+int Run(const std::string& name, TestFunction test)
+{
+    try
+    {
+        test();
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << name << " failed: " << exception.what() << "\n";
+        return 1;
+    }
+
+    std::cout << name << " passed.\n";
+    return 0;
+}
+
+}
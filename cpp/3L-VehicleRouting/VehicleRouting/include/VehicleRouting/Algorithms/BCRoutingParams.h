@@ -127,6 +127,14 @@ struct BranchAndCutParams
     bool EnableMinVehicleLifting = true;
     double MinVehicleLiftingThreshold = 0.5;
 
+    /// Start the search for a minimal infeasible subset (TwoPathMIS) from the infeasible core of one CP solve.
+    /// Not benchmarked yet -> disabled by default, see Tests/InfeasibleCoreTest.cpp.
+    bool EnableInfeasibleCores = false;
+
+    /// Exact route checks solve the complete model and its relaxations concurrently instead of one after another.
+    /// Not benchmarked yet -> disabled by default.
+    bool EnableLoadingPortfolio = false;
+
     bool ActivateIntraRouteImprovement = false;
     unsigned int IntraRouteFullEnumThreshold = 0;
 
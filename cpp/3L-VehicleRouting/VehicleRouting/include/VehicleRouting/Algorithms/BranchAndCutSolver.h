@@ -27,12 +27,14 @@ class BranchAndCutSolver
                        GRBEnv* env,
                        const VehicleRouting::InputParameters& inputParameters,
                        const std::string& startSolutionFolderPath,
-                       const std::string& outputPath)
+                       const std::string& outputPath,
+                       const std::string& loadingCacheFile = "")
     : mEnv(env),
       mInstance(instance),
       mInputParameters(inputParameters),
       mStartSolutionFolderPath(startSolutionFolderPath),
-      mOutputPath(outputPath)
+      mOutputPath(outputPath),
+      mLoadingCacheFile(loadingCacheFile)
     {
         mLogFile.open(env->get(GRB_StringParam_LogFile), std::ios::out | std::ios::app);
     }
@@ -45,6 +47,8 @@ class BranchAndCutSolver
     InputParameters mInputParameters;
     std::string mStartSolutionFolderPath;
     std::string mOutputPath;
+    /// Persistent loading cache file, disabled if empty.
+    std::string mLoadingCacheFile;
 
     std::ofstream mLogFile;
     std::vector<Arc> mInfeasibleArcs;
@@ -70,8 +74,13 @@ class BranchAndCutSolver
     size_t DetermineLowerBoundVehicles();
 
     void Initialize();
+    /// Throws if a customer cannot be served by a single vehicle.
+    void CheckSingleCustomerRoutes();
+    [[nodiscard]] uint64_t DetermineLoadingCacheKey(const Container& container) const;
     void TestProcedure();
     void Preprocessing();
+    /// Number and time (microseconds) of geometric bound checks before CP calls, BoundCheck counts all checks.
+    void AddGeometricBoundStatistics(CallbackTracker& tracker) const;
     void DeterminePackingSolution();
     void PrintSolution();
 
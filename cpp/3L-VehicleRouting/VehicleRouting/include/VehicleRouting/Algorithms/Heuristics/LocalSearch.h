@@ -33,7 +33,7 @@ class LocalSearch
             return;
         }
 
-        if (sequence.size() < 3)
+        if (sequence.size() < 3 || loadingChecker->GetStopToken().StopRequested())
         {
             return;
         }
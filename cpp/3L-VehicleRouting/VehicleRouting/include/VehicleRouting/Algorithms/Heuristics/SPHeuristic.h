@@ -41,7 +41,12 @@ class SPHeuristic
     const InputParameters* const mInputParameters;
     double mSCObjVal = 0.0;
     double mSPObjVal = 0.0;
-    std::vector<double> CalcCosts(const auto& columns);
+
+    /// Feasible routes of the loading checker in the same order, extended by new routes in each run.
+    Collections::SequenceVector mColumns;
+    std::vector<double> mCosts;
+
+    void UpdateColumns();
     Collections::SequenceVector CreateRoutesCustomerRemoval(auto& routes);
     void AddNewRoutes(auto& routes);
 };
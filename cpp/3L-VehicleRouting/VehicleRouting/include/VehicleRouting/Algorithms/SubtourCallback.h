@@ -212,6 +212,11 @@ class SubtourCallback3DAll : public SubtourCallback3D
   private:
     bool Lifting(const Subtour& subtour, Container& container, std::vector<Cuboid>& items) override;
     LoadingStatus CheckRouteExact(const Subtour& subtour, Container& container, std::vector<Cuboid>& items) override;
+    /// Complete model and the relaxations of Lifting are raced, see LoadingChecker::RaceConstraintProgrammingSolvers.
+    LoadingStatus CheckRouteExactPortfolio(const Subtour& subtour, Container& container, std::vector<Cuboid>& items);
+    /// Complete model with the residual runtime of the MIP after an unknown status and unsuccessful lifting.
+    LoadingStatus CheckRouteExactResidual(const Subtour& subtour, Container& container, std::vector<Cuboid>& items);
+    LoadingStatus AddInfeasibleRouteConstraints(const Subtour& subtour, Container& container);
     void AddReversePathConstraints(const Collections::IdVector& sequence,
                                    const Collections::IdVector& reverseSequence) override;
 };
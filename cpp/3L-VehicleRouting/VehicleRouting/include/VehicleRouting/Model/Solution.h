@@ -4,6 +4,9 @@
 #include "Algorithms/Evaluation.h"
 #include "Helper/Timer.h"
 
+#include "ContainerLoading/Helper/ClockCache.h"
+#include "ContainerLoading/Helper/LoadingCacheCounters.h"
+
 #include "Model/Instance.h"
 #include "Node.h"
 #include "Vehicle.h"
@@ -67,6 +70,13 @@ enum class CallbackElement
     RevExactFeas,
     RevExactInf,
     InfeasibleTailPathInequality,
+    // Geometric bounds before CP, see ContainerLoading::GeometricBound
+    BoundCheck,
+    BoundItemDimensions,
+    BoundLargeItems,
+    BoundDualFeasible,
+    BoundFloorArea,
+    BoundCumulative,
     // Fractional
     FractionalSolutions,
     AddFracSolCuts,
@@ -129,6 +139,8 @@ class Tour
     Node Depot;
     Model::Vehicle Vehicle;
     std::vector<Node> Route;
+    /// False if no packing of the route was found within the runtime limit of the final check.
+    bool PackingVerified = true;
 
     Tour() = default;
     Tour(const Node& depot, const Model::Vehicle& vehicle, std::vector<Node>& route)
@@ -178,6 +190,9 @@ class SolverStatistics
     size_t InfeasibleTailPathStart = 0;
     CallbackTracker SubtourTracker;
     Helper::Timer Timer;
+    std::vector<ContainerLoading::LoadingCacheStatistics> LoadingCaches;
+    std::vector<ContainerLoading::CacheLookupStatistics> LoadingCacheLookups;
+    std::vector<ContainerLoading::CPSolveStatistics> LoadingSolves;
 
     SolverStatistics(double runtime,
                      double gap,
@@ -18,8 +18,13 @@
 #include "Algorithms/SubtourCallback.h"
 #include "Algorithms/VehicleRoutingModels.h"
 
+#include <algorithm>
+#include <atomic>
+#include <csignal>
 #include <cstdint>
+#include <future>
 #include <memory>
+#include <thread>
 
 namespace VehicleRouting
 {
@@ -33,6 +38,43 @@ using namespace ContainerLoading::Algorithms;
 using namespace Heuristics::Improvement;
 using namespace Helper;
 
+namespace
+{
+/// Stop token of the running solver, see InterruptGuard.
+std::atomic<StopToken*> InterruptedStopToken = nullptr;
+
+void RequestStopOnInterrupt(int /*signal*/)
+{
+    if (auto* stopToken = InterruptedStopToken.load(); stopToken != nullptr)
+    {
+        stopToken->RequestStop();
+    }
+}
+
+/// Requests a stop of the token on SIGINT while in scope. Gurobi handles SIGINT itself during the optimization.
+class InterruptGuard
+{
+  public:
+    explicit InterruptGuard(StopToken& stopToken)
+    {
+        InterruptedStopToken = &stopToken;
+        mPreviousHandler = std::signal(SIGINT, RequestStopOnInterrupt);
+    }
+
+    ~InterruptGuard()
+    {
+        std::signal(SIGINT, mPreviousHandler);
+        InterruptedStopToken = nullptr;
+    }
+
+    InterruptGuard(const InterruptGuard&) = delete;
+    InterruptGuard& operator=(const InterruptGuard&) = delete;
+
+  private:
+    void (*mPreviousHandler)(int) = SIG_DFL;
+};
+}
+
 void BranchAndCutSolver::Initialize()
 {
     mLogFile << "ProblemVariant: " << (int)mInputParameters.ContainerLoading.LoadingProblem.Variant << "\n";
@@ -59,15 +101,36 @@ void BranchAndCutSolver::Initialize()
     }
 
     mLoadingChecker = std::make_unique<LoadingChecker>(mInputParameters.ContainerLoading);
+    // The time limit covers the whole run: preprocessing, start solution, and branch-and-cut.
+    mLoadingChecker->GetStopToken().SetTimeLimit(mInputParameters.MIPSolver.TimeLimit);
     mLoadingChecker->SetBinPackingModel(mEnv, containers, customerNodes, mOutputPath);
 
+    if (!mLoadingCacheFile.empty())
+    {
+        auto importedEntries =
+            mLoadingChecker->EnablePersistentCache(mLoadingCacheFile, DetermineLoadingCacheKey(containers[0]));
+        mLogFile << "Imported loading results from cache: " << std::to_string(importedEntries) << "\n";
+    }
+
+    mRNG.seed(1008);
+}
+
+void BranchAndCutSolver::CheckSingleCustomerRoutes()
+{
+    const auto& container = mInstance->Vehicles.front().Containers.front();
+    const auto& stopToken = mLoadingChecker->GetStopToken();
     for (const auto& customer: mInstance->GetCustomers())
     {
+        if (stopToken.StopRequested())
+        {
+            break;
+        }
+
         Collections::IdVector route = {customer.InternId};
 
         auto items = InterfaceConversions::SelectItems(route, mInstance->Nodes, false);
 
-        auto heurStatus = mLoadingChecker->PackingHeuristic(PackingType::Complete, containers[0], route, items);
+        auto heurStatus = mLoadingChecker->PackingHeuristic(PackingType::Complete, container, route, items);
 
         if (heurStatus == LoadingStatus::FeasOpt)
         {
@@ -76,32 +139,43 @@ void BranchAndCutSolver::Initialize()
 
         auto exactStatus =
             mLoadingChecker->ConstraintProgrammingSolver(PackingType::Complete,
-                                                         containers[0],
+                                                         container,
                                                          mLoadingChecker->MakeBitset(mInstance->Nodes.size(), route),
                                                          route,
                                                          items,
                                                          mInputParameters.IsExact(BranchAndCutParams::CallType::Exact));
 
-        if (exactStatus != LoadingStatus::FeasOpt)
+        // Exact calls return Invalid after a stop.
+        if (exactStatus != LoadingStatus::FeasOpt && !stopToken.StopRequested())
         {
             mLogFile << "Single customer route with " << customer.InternId << "is infeasible.\n";
 
             auto relStatus = mLoadingChecker->ConstraintProgrammingSolver(
                 PackingType::NoSupport,
-                containers[0],
+                container,
                 mLoadingChecker->MakeBitset(mInstance->Nodes.size(), route),
                 route,
                 items,
                 mInputParameters.IsExact(BranchAndCutParams::CallType::Exact));
 
-            if (relStatus != LoadingStatus::FeasOpt)
+            if (relStatus != LoadingStatus::FeasOpt && !stopToken.StopRequested())
             {
                 throw std::runtime_error("Single customer route is infeasible!");
             }
         }
     }
+}
 
-    mRNG.seed(1008);
+uint64_t BranchAndCutSolver::DetermineLoadingCacheKey(const Container& container) const
+{
+    // Loading results only depend on container, items of each node, and the loading problem; not on node positions.
+    uint64_t key = PersistentLoadingCache::HashContainer(0, container);
+    for (const auto& node: mInstance->Nodes)
+    {
+        key = PersistentLoadingCache::HashItems(key, node.Items);
+    }
+
+    return PersistentLoadingCache::HashValue(key, mInputParameters.ContainerLoading.LoadingProblem.SupportArea);
 }
 
 void BranchAndCutSolver::TestProcedure()
@@ -229,6 +303,12 @@ void BranchAndCutSolver::StartSolutionProcedure()
 
     std::vector<Route> startRoutes;
 
+    if (mLoadingChecker->GetStopToken().StopRequested())
+    {
+        mLogFile << "No start solution: stop requested.\n";
+        return;
+    }
+
     switch (mInputParameters.BranchAndCut.StartSolution)
     {
         case None:
@@ -246,6 +326,12 @@ void BranchAndCutSolver::StartSolutionProcedure()
             throw std::runtime_error("Start solution type not implemented.");
     }
 
+    if (startRoutes.empty())
+    {
+        mLogFile << "No start solution found.\n";
+        return;
+    }
+
     for (const auto& route: startRoutes)
     {
         mStartSolutionArcs.emplace_back(1.0, mInstance->GetDepotId(), route.Sequence.front());
@@ -305,6 +391,10 @@ std::vector<Route> BranchAndCutSolver::GenerateStartSolution()
     auto spHeuristic = Heuristics::SetBased::SPHeuristic(mInstance, mLoadingChecker.get(), &mInputParameters, mEnv);
 
     auto sequences = spHeuristic.Run(std::numeric_limits<double>::max());
+    if (!sequences)
+    {
+        return {};
+    }
 
     std::vector<Route> solution;
     int id = 0;
@@ -597,7 +687,9 @@ void BranchAndCutSolver::DetermineInfeasiblePaths()
 
     auto& container = mInstance->Vehicles.front().Containers.front();
     const auto& nodes = mInstance->Nodes;
-    for (size_t iNode = 1; iNode < nodes.size() - 1; ++iNode)
+    const auto& stopToken = mLoadingChecker->GetStopToken();
+    // Arcs and combinations found so far are valid -> the procedure is stopped between customers.
+    for (size_t iNode = 1; iNode < nodes.size() - 1 && !stopToken.StopRequested(); ++iNode)
     {
         // mLogFile << "Node: " << std::to_string(iNode) << "\n";
         for (size_t jNode = iNode + 1; jNode < nodes.size(); ++jNode)
@@ -647,13 +739,31 @@ bool BranchAndCutSolver::CheckPath(const Collections::IdVector& path, Container&
         }
     }
 
-    auto statusSupportRelaxation =
-        mLoadingChecker->ConstraintProgrammingSolver(PackingType::NoSupport,
-                                                     container,
-                                                     mLoadingChecker->MakeBitset(mInstance->Nodes.size(), path),
-                                                     path,
-                                                     items,
-                                                     mInputParameters.IsExact(BranchAndCutParams::CallType::Exact));
+    const auto set = mLoadingChecker->MakeBitset(mInstance->Nodes.size(), path);
+    const auto isCallTypeExact = mInputParameters.IsExact(BranchAndCutParams::CallType::Exact);
+
+    auto statusSupportRelaxation = LoadingStatus::Unknown;
+    auto statusComplete = LoadingStatus::Unknown;
+    if (mInputParameters.BranchAndCut.EnableLoadingPortfolio)
+    {
+        // Infeasibility of the complete model does not decide the relaxation -> only feasibility stops the race.
+        const std::vector<CPRaceEntry> entries = {
+            {PackingType::NoSupport, set, isCallTypeExact, std::numeric_limits<double>::max(), true, false},
+            {PackingType::Complete, set, isCallTypeExact, std::numeric_limits<double>::max(), false, true}};
+        const auto statuses = mLoadingChecker->RaceConstraintProgrammingSolvers(entries, container, path, items);
+        statusSupportRelaxation = statuses[0];
+        statusComplete = statuses[1];
+    }
+    else
+    {
+        statusSupportRelaxation = mLoadingChecker->ConstraintProgrammingSolver(
+            PackingType::NoSupport, container, set, path, items, isCallTypeExact);
+        if (statusSupportRelaxation != LoadingStatus::Infeasible)
+        {
+            statusComplete = mLoadingChecker->ConstraintProgrammingSolver(
+                PackingType::Complete, container, set, path, items, isCallTypeExact);
+        }
+    }
 
     if (statusSupportRelaxation == LoadingStatus::Infeasible)
     {
@@ -661,14 +771,6 @@ bool BranchAndCutSolver::CheckPath(const Collections::IdVector& path, Container&
         return false;
     }
 
-    auto statusComplete =
-        mLoadingChecker->ConstraintProgrammingSolver(PackingType::Complete,
-                                                     container,
-                                                     mLoadingChecker->MakeBitset(mInstance->Nodes.size(), path),
-                                                     path,
-                                                     items,
-                                                     mInputParameters.IsExact(BranchAndCutParams::CallType::Exact));
-
     if (statusComplete == LoadingStatus::Infeasible)
     {
         mInfeasibleTailPaths.emplace_back(0, path.front(), path.back());
@@ -693,6 +795,11 @@ void BranchAndCutSolver::DetermineExtendedInfeasiblePath()
 
     for (auto& arc: mInfeasibleTailPaths)
     {
+        if (mLoadingChecker->GetStopToken().StopRequested())
+        {
+            break;
+        }
+
         const auto& nodeI = nodes[arc.Tail];
         const auto& nodeJ = nodes[arc.Head];
 
@@ -724,6 +831,9 @@ void BranchAndCutSolver::DetermineExtendedInfeasiblePath()
                     mLoadingChecker->PackingHeuristic(PackingType::Complete, container, path, selectedItems);
             }
 
+            // The heuristic proves only feasibility, the arc is deleted only if the relaxation is infeasible for
+            // every extension. The CP check is limited to the time limit of two-arc paths, an unknown result keeps
+            // the arc.
             if (heuristicStatus == LoadingStatus::Infeasible)
             {
                 auto statusSupportRelaxation = mLoadingChecker->ConstraintProgrammingSolver(
@@ -732,7 +842,8 @@ void BranchAndCutSolver::DetermineExtendedInfeasiblePath()
                     mLoadingChecker->MakeBitset(mInstance->Nodes.size(), path),
                     path,
                     selectedItems,
-                    mInputParameters.IsExact(BranchAndCutParams::CallType::Exact));
+                    mInputParameters.IsExact(BranchAndCutParams::CallType::TwoPath),
+                    mInputParameters.DetermineMaxRuntime(BranchAndCutParams::CallType::TwoPath));
 
                 if (statusSupportRelaxation == LoadingStatus::Infeasible)
                 {
@@ -804,8 +915,9 @@ void BranchAndCutSolver::DetermineInfeasibleCustomerCombinations()
                     nodesInSet.set(kNode);
 
                     double maxRuntime = mInputParameters.DetermineMaxRuntime(BranchAndCutParams::CallType::Exact);
+                    // Any visiting order of the combination -> relaxation with LIFO without given sequence.
                     auto status = mLoadingChecker->ConstraintProgrammingSolver(
-                        PackingType::NoSupportNoSequence,
+                        PackingType::LifoNoSequence,
                         container,
                         nodesInSet,
                         path,
@@ -871,6 +983,8 @@ void BranchAndCutSolver::Solve()
     Serializer::WriteToJson(mInputParameters, mOutputPath, parameterString);
 
     Initialize();
+    InterruptGuard interruptGuard(mLoadingChecker->GetStopToken());
+    CheckSingleCustomerRoutes();
 
     ////TestProcedure();
 
@@ -889,10 +1003,27 @@ void BranchAndCutSolver::Solve()
                                                     &mInputParameters,
                                                     mOutputPath);
     branchAndCut.SetCallback(callback.get());
-    branchAndCut.Solve(mInputParameters.MIPSolver);
+
+    auto mipSolverParameters = mInputParameters.MIPSolver;
+    mipSolverParameters.TimeLimit =
+        std::min(mipSolverParameters.TimeLimit, mLoadingChecker->GetStopToken().RemainingTime());
+    branchAndCut.Solve(mipSolverParameters);
 
     mTimer.BranchAndCut = std::chrono::system_clock::now() - start;
 
+    mLoadingChecker->SavePersistentCache();
+
+    const auto combinationStatistics = mLoadingChecker->GetInfeasibleCombinationStatistics();
+    mLogFile << "Infeasible customer combinations: " << std::to_string(mLoadingChecker->GetSizeInfeasibleCombinations())
+             << " | Inserted: " << std::to_string(combinationStatistics.Inserted)
+             << " | Dominated: " << std::to_string(combinationStatistics.RejectedDominated)
+             << " | Removed supersets: " << std::to_string(combinationStatistics.RemovedSupersets) << "\n";
+    mLogFile << "Infeasible customer combination queries: " << std::to_string(combinationStatistics.Queries)
+             << " | Hits: " << std::to_string(combinationStatistics.Hits)
+             << " | Compared: " << std::to_string(combinationStatistics.ComparedCombinations) << "\n";
+
+    AddGeometricBoundStatistics(callback->CallbackTracker);
+
     auto statistics = SolverStatistics(branchAndCut.GetRuntime(),
                                        branchAndCut.GetMIPGap(),
                                        branchAndCut.GetNodeCount(),
@@ -901,6 +1032,9 @@ void BranchAndCutSolver::Solve()
                                        mTimer,
                                        mInfeasibleArcs.size(),
                                        mInfeasibleTailPaths.size());
+    statistics.LoadingCaches = mLoadingChecker->GetCacheStatistics();
+    statistics.LoadingCacheLookups = mLoadingChecker->GetCacheCounters().Lookups();
+    statistics.LoadingSolves = mLoadingChecker->GetCacheCounters().Solves();
 
     std::string solutionStatisticsString = "SolutionStatistics-" + mInstance->Name;
     Serializer::WriteToJson(statistics, mOutputPath, solutionStatisticsString);
@@ -927,8 +1061,66 @@ void BranchAndCutSolver::Solve()
     WriteSolutionSolutionValidator();
 }
 
+void BranchAndCutSolver::AddGeometricBoundStatistics(CallbackTracker& tracker) const
+{
+    for (const auto& bound: mLoadingChecker->GetCacheCounters().Bounds())
+    {
+        const auto time = static_cast<uint64_t>(bound.Time * 1e6);
+        tracker.Counter[CallbackElement::BoundCheck] += static_cast<int>(bound.Hits);
+        tracker.Timer[CallbackElement::BoundCheck] += time;
+
+        auto element = CallbackElement::None;
+        switch (bound.Bound)
+        {
+            case GeometricBound::ItemDimensions:
+                element = CallbackElement::BoundItemDimensions;
+                break;
+            case GeometricBound::LargeItems:
+                element = CallbackElement::BoundLargeItems;
+                break;
+            case GeometricBound::DualFeasibleFunctions:
+                element = CallbackElement::BoundDualFeasible;
+                break;
+            case GeometricBound::FloorArea:
+                element = CallbackElement::BoundFloorArea;
+                break;
+            case GeometricBound::CumulativeProfile:
+                element = CallbackElement::BoundCumulative;
+                break;
+            default:
+                continue;
+        }
+
+        tracker.Counter[element] += static_cast<int>(bound.Hits);
+        tracker.Timer[element] += time;
+    }
+}
+
 void BranchAndCutSolver::DeterminePackingSolution()
 {
+    struct MissingPacking
+    {
+        size_t TourId = 0;
+        Collections::IdVector StopIds;
+        std::vector<Cuboid> Items;
+    };
+
+    auto assignPacking = [](std::vector<Node>& route, const std::vector<Cuboid>& packedItems)
+    {
+        size_t cItems = 0;
+        for (auto& stop: route)
+        {
+            for (auto& item: stop.Items)
+            {
+                item = packedItems[cItems];
+                cItems++;
+            }
+        }
+    };
+
+    // Routes without stored packing are re-solved after all routes have been checked.
+    std::vector<MissingPacking> missingPackings;
+
     mFinalSolution.NumberOfRoutes = mFinalSolution.Tours.size();
     for (size_t tourId = 0; tourId < mFinalSolution.Tours.size(); tourId++)
     {
@@ -978,39 +1170,87 @@ void BranchAndCutSolver::DeterminePackingSolution()
             continue;
         }
 
-        auto heuristicStatus = LoadingStatus::Infeasible;
-        if (mInputParameters.BranchAndCut.ActivateHeuristic)
+        auto hasCertificate = mLoadingChecker->GetPackingCertificate(stopIds, selectedItems);
+        if (!hasCertificate && mInputParameters.BranchAndCut.ActivateHeuristic)
         {
-            heuristicStatus =
+            // A successful heuristic stores its packing as certificate.
+            auto heuristicStatus =
                 mLoadingChecker->PackingHeuristic(PackingType::Complete, container, stopIds, selectedItems);
+            hasCertificate = heuristicStatus == LoadingStatus::FeasOpt
+                             && mLoadingChecker->GetPackingCertificate(stopIds, selectedItems);
         }
 
-        std::string feasStatusHeur = heuristicStatus == LoadingStatus::FeasOpt ? "feasible" : "infeasible";
-        mLogFile << feasStatusHeur << " with packing heuristic | ";
-
-        double maxRuntime = mInputParameters.DetermineMaxRuntime(BranchAndCutParams::CallType::Exact);
-        auto exactStatus = mLoadingChecker->ConstraintProgrammingSolverGetPacking(
-            PackingType::Complete, container, stopIds, selectedItems, maxRuntime);
+        if (hasCertificate)
+        {
+            mLogFile << "feasible with packing certificate"
+                     << "\n";
+            assignPacking(route, selectedItems);
+            continue;
+        }
 
-        std::string feasStatusCP = exactStatus == LoadingStatus::FeasOpt ? "feasible" : "infeasible";
-        mLogFile << feasStatusCP << " with CP model"
+        mLogFile << "no packing certificate"
                  << "\n";
+        missingPackings.push_back(MissingPacking{tourId, std::move(stopIds), std::move(selectedItems)});
+    }
 
-        // TODO: packing as return value of loading checker
+    if (missingPackings.empty())
+    {
+        return;
+    }
 
-        if (exactStatus == LoadingStatus::Infeasible)
+    // Each CP solve uses several threads itself.
+    const auto threadsPerSolve = static_cast<size_t>(std::max(1, mInputParameters.ContainerLoading.CPSolver.Threads));
+    const auto numberParallelSolves = std::max<size_t>(1, std::thread::hardware_concurrency() / threadsPerSolve);
+    const auto maxRuntime = mInputParameters.DetermineMaxRuntime(BranchAndCutParams::CallType::Exact);
+
+    for (size_t first = 0; first < missingPackings.size(); first += numberParallelSolves)
+    {
+        const auto last = std::min(first + numberParallelSolves, missingPackings.size());
+
+        std::vector<std::future<LoadingStatus>> exactStatuses;
+        for (size_t k = first; k < last; ++k)
         {
-            throw std::runtime_error("Loading infeasible according to CP model.");
+            auto& missingPacking = missingPackings[k];
+            const auto& container = mFinalSolution.Tours[missingPacking.TourId].Vehicle.Containers.front();
+            exactStatuses.push_back(std::async(std::launch::async,
+                                               [this, &container, &missingPacking, maxRuntime]()
+                                               {
+                                                   return mLoadingChecker->ConstraintProgrammingSolverGetPacking(
+                                                       PackingType::Complete,
+                                                       container,
+                                                       missingPacking.StopIds,
+                                                       missingPacking.Items,
+                                                       maxRuntime);
+                                               }));
         }
 
-        size_t cItems = 0;
-        for (auto& stop: route)
+        for (size_t k = first; k < last; ++k)
         {
-            for (auto& item: stop.Items)
+            auto& missingPacking = missingPackings[k];
+            const auto exactStatus = exactStatuses[k - first].get();
+
+            std::string feasStatusCP = exactStatus == LoadingStatus::FeasOpt      ? "feasible"
+                                       : exactStatus == LoadingStatus::Infeasible ? "infeasible"
+                                                                                  : "not decided";
+            mLogFile << "Route " << std::to_string(missingPacking.TourId) << ": " << feasStatusCP << " with CP model"
+                     << "\n";
+
+            if (exactStatus == LoadingStatus::Infeasible)
             {
-                item = selectedItems[cItems];
-                cItems++;
+                throw std::runtime_error("Loading infeasible according to CP model.");
             }
+
+            // Not decided within the runtime limit -> the solution is kept, but its packing is missing.
+            auto& tour = mFinalSolution.Tours[missingPacking.TourId];
+            if (exactStatus != LoadingStatus::FeasOpt)
+            {
+                mLogFile << "Route " << std::to_string(missingPacking.TourId) + tour.Print() << ": packing not verified"
+                         << "\n";
+                tour.PackingVerified = false;
+                continue;
+            }
+
+            assignPacking(tour.Route, missingPacking.Items);
         }
     }
 }
@@ -67,8 +67,24 @@ std::optional<Collections::IdVector>
                                                                boost::dynamic_bitset<>& set,
                                                                const Container& container)
 {
+    // The core is infeasible itself and only shrunk further by removing customers.
+    auto candidates = sequence;
+    if (mInputParameters->BranchAndCut.EnableInfeasibleCores)
+    {
+        auto items = InterfaceConversions::SelectItems(sequence, mInstance->Nodes, false);
+        double maxRuntime = mInputParameters->DetermineMaxRuntime(BranchAndCutParams::CallType::MinInfSet);
+        auto core = mLoadingChecker->DetermineInfeasibleCore(
+            PackingType::LifoNoSequence, container, set, sequence, items, maxRuntime);
+
+        if (!core.empty() && core.size() < sequence.size())
+        {
+            candidates = std::move(core);
+            set = mLoadingChecker->MakeBitset(set.size(), candidates);
+        }
+    }
+
     std::vector<std::pair<double, size_t>> volumes;
-    for (const auto nodeI: sequence)
+    for (const auto nodeI: candidates)
     {
         volumes.push_back(std::make_pair(mInstance->Nodes[nodeI].TotalVolume, nodeI));
     }
@@ -76,7 +92,7 @@ std::optional<Collections::IdVector>
     std::ranges::sort(volumes);
 
     Collections::IdVector sortedSubset;
-    for (size_t i = 0; i < sequence.size(); ++i)
+    for (size_t i = 0; i < candidates.size(); ++i)
     {
         sortedSubset.push_back(volumes[i].second);
     }
@@ -125,7 +141,7 @@ std::optional<Collections::IdVector>
         break;
     }
 
-    if (indexLastNode == 0)
+    if (indexLastNode == 0 && candidates.size() == sequence.size())
     {
         return std::nullopt;
     }
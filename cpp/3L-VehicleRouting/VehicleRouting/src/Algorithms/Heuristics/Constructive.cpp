@@ -48,7 +48,8 @@ std::vector<Route> Savings::Run()
 
     std::ranges::sort(savingsValues);
 
-    while (!savingsValues.empty())
+    // Routes merged so far are feasible -> a stopped run still returns a solution.
+    while (!savingsValues.empty() && !mLoadingChecker->GetStopToken().StopRequested())
     {
         auto nodeI = std::get<1>(savingsValues.front());
         auto nodeJ = std::get<2>(savingsValues.front());
@@ -179,7 +180,8 @@ void ModifiedSavings::RepairProcedure(std::vector<Route>& solution)
 
     solution.erase(std::begin(solution) + static_cast<int>(mInstance->Vehicles.size()), std::end(solution));
 
-    while (!notVisitedCustomers.empty())
+    // The repaired solution only seeds feasible routes -> customers may be left out after a stop.
+    while (!notVisitedCustomers.empty() && !mLoadingChecker->GetStopToken().StopRequested())
     {
         std::ranges::sort(notVisitedCustomers,
                           [&](const auto& idA, const auto& idB)
@@ -289,7 +291,7 @@ Collections::IdVector ModifiedSavings::InsertInRandomRoute(Route& route, size_t
     bool nodeInserted = false;
     const auto& node = mInstance->Nodes[nodeToInsert];
 
-    while (!nodeInserted)
+    while (!nodeInserted && !mLoadingChecker->GetStopToken().StopRequested())
     {
         std::uniform_int_distribution<> distrib(0, static_cast<int>(route.Sequence.size() - 1));
         auto positionToRemove = distrib(*mRNG);
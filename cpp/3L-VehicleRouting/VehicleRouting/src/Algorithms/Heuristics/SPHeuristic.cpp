@@ -21,10 +21,15 @@ namespace SetBased
 {
 std::optional<Collections::SequenceVector> SPHeuristic::Run(double cutoff)
 {
-    auto costs = CalcCosts(mLoadingChecker->GetFeasibleRoutes());
+    if (mLoadingChecker->GetStopToken().StopRequested())
+    {
+        return std::nullopt;
+    }
+
+    UpdateColumns();
 
     auto setCovering = BaseModels::SetCovering<Collections::SequenceVector>(
-        mEnv, true, mLoadingChecker->GetFeasibleRoutes(), mInstance->CustomerIds, costs, mInstance->Vehicles.size());
+        mEnv, true, mColumns, mInstance->CustomerIds, mCosts, mInstance->Vehicles.size());
 
     if (!setCovering.Solve())
     {
@@ -44,10 +49,10 @@ std::optional<Collections::SequenceVector> SPHeuristic::Run(double cutoff)
 
     AddNewRoutes(newRoutes);
 
-    costs = CalcCosts(mLoadingChecker->GetFeasibleRoutes());
+    UpdateColumns();
 
     auto setPartitioning = BaseModels::SetPartitioning<Collections::SequenceVector>(
-        mEnv, false, mLoadingChecker->GetFeasibleRoutes(), mInstance->CustomerIds, costs, mInstance->Vehicles.size());
+        mEnv, false, mColumns, mInstance->CustomerIds, mCosts, mInstance->Vehicles.size());
 
     if (!setPartitioning.Solve())
     {
@@ -66,16 +71,14 @@ std::optional<Collections::SequenceVector> SPHeuristic::Run(double cutoff)
     return newSolution;
 }
 
-std::vector<double> SPHeuristic::CalcCosts(const auto& columns)
+void SPHeuristic::UpdateColumns()
 {
-    auto costs = std::vector<double>();
-
-    for (const auto& route: columns)
+    // Only routes added since the last update are fetched and evaluated.
+    for (auto& route: mLoadingChecker->GetFeasibleRoutes(mColumns.size()))
     {
-        costs.push_back(Evaluator::CalculateRouteCosts(mInstance, route));
+        mCosts.push_back(Evaluator::CalculateRouteCosts(mInstance, route));
+        mColumns.push_back(std::move(route));
     }
-
-    return costs;
 }
 
 void SPHeuristic::AddNewRoutes(auto& routes)
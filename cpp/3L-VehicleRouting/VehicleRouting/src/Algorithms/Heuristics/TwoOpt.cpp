@@ -30,8 +30,9 @@ void TwoOpt::Run(const Instance* const instance,
         return;
     }
 
+    // A stopped search is not marked as checked.
     Collections::IdVector tmpRoute = newRoute;
-    while (true)
+    while (!loadingChecker->GetStopToken().StopRequested())
     {
         auto moves = DetermineMoves(instance, tmpRoute);
         auto bestMove = GetBestMove(instance, inputParameters, loadingChecker, tmpRoute, moves);
@@ -24,6 +24,14 @@ void SubtourCallback::callback()
 {
     try
     {
+        // Deadline or stop request of the run. Integer solutions are still checked: CP calls return Invalid after the
+        // stop, which aborts the optimization without accepting the solution.
+        if (where != GRB_CB_MIPSOL && mLoadingChecker->GetStopToken().StopRequested())
+        {
+            this->abort();
+            return;
+        }
+
         switch (where)
         {
             case GRB_CB_MIP:
@@ -363,7 +371,6 @@ bool SubtourCallback::CustomerCombinationInfeasible(const Collections::IdVector&
     if (mLoadingChecker->CustomerCombinationInfeasible(combination))
     {
         AddLazyConstraints({mLazyConstraintsGenerator->CreateConstraint(CutType::SEC, sequence, 2)});
-        mLoadingChecker->AddInfeasibleCombination(combination);
         mClock.end();
         CallbackTracker.UpdateElement(CallbackElement::CustCombiInf, mClock.elapsed());
 
@@ -908,6 +915,11 @@ bool SubtourCallback3DAll::Lifting(const Subtour& subtour, Container& container,
 LoadingStatus
     SubtourCallback3DAll::CheckRouteExact(const Subtour& subtour, Container& container, std::vector<Cuboid>& items)
 {
+    if (mInputParameters->BranchAndCut.EnableLoadingPortfolio)
+    {
+        return CheckRouteExactPortfolio(subtour, container, items);
+    }
+
     // Solve complete CP model with time limit
     // Try lifting although sequence might be feasible (status unknown with time limit)
     // Reasoning: feasibility can be proven quickly -> mabye lifting with relaxed problem is faster than solving
@@ -953,42 +965,160 @@ LoadingStatus
     }
 
     // Solve complete CP model again if unknown to prove feasibility/infeasibility
-    mClock.start();
     if (exactStatus == LoadingStatus::Unknown)
     {
-        double residualTime = mInputParameters->MIPSolver.TimeLimit - this->getDoubleInfo(GRB_CB_RUNTIME);
-        double maxRuntime = mInputParameters->DetermineMaxRuntime(BranchAndCutParams::CallType::Exact, residualTime);
+        return CheckRouteExactResidual(subtour, container, items);
+    }
 
-        exactStatus =
-            mLoadingChecker->ConstraintProgrammingSolver(PackingType::Complete,
-                                                         container,
-                                                         subtour.CustomersInRoute,
-                                                         subtour.Sequence,
-                                                         items,
-                                                         mInputParameters->IsExact(BranchAndCutParams::CallType::Exact),
-                                                         maxRuntime);
+    return AddInfeasibleRouteConstraints(subtour, container);
+}
 
-        switch (exactStatus)
-        {
-            case LoadingStatus::FeasOpt:
-                LocalSearch::RunIntraImprovement(mInstance, mLoadingChecker, mInputParameters, subtour.Sequence);
-                mClock.end();
-                CallbackTracker.UpdateElement(CallbackElement::ExactFeas, mClock.elapsed());
-                return LoadingStatus::FeasOpt;
-            case LoadingStatus::Infeasible:
-                mClock.end();
-                CallbackTracker.UpdateElement(CallbackElement::ExactInf, mClock.elapsed());
+LoadingStatus SubtourCallback3DAll::CheckRouteExactResidual(const Subtour& subtour,
+                                                            Container& container,
+                                                            std::vector<Cuboid>& items)
+{
+    mClock.start();
+    double residualTime = mInputParameters->MIPSolver.TimeLimit - this->getDoubleInfo(GRB_CB_RUNTIME);
+    double maxRuntime = mInputParameters->DetermineMaxRuntime(BranchAndCutParams::CallType::Exact, residualTime);
+
+    auto exactStatus =
+        mLoadingChecker->ConstraintProgrammingSolver(PackingType::Complete,
+                                                     container,
+                                                     subtour.CustomersInRoute,
+                                                     subtour.Sequence,
+                                                     items,
+                                                     mInputParameters->IsExact(BranchAndCutParams::CallType::Exact),
+                                                     maxRuntime);
+
+    switch (exactStatus)
+    {
+        case LoadingStatus::FeasOpt:
+            LocalSearch::RunIntraImprovement(mInstance, mLoadingChecker, mInputParameters, subtour.Sequence);
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::ExactFeas, mClock.elapsed());
+            return LoadingStatus::FeasOpt;
+        case LoadingStatus::Infeasible:
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::ExactInf, mClock.elapsed());
+            break;
+        case LoadingStatus::Invalid:
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::ExactInvalid, mClock.elapsed());
+            return LoadingStatus::Invalid;
+        case LoadingStatus::Unknown:
+            mClock.end();
+            throw std::runtime_error("LoadingStatus is Unknown after exact CP model in CheckRouteExact().");
+    }
+
+    return AddInfeasibleRouteConstraints(subtour, container);
+}
+
+LoadingStatus SubtourCallback3DAll::CheckRouteExactPortfolio(const Subtour& subtour,
+                                                             Container& container,
+                                                             std::vector<Cuboid>& items)
+{
+    using enum BranchAndCutParams::CallType;
+
+    // The complete model is not stopped by its own infeasibility: cuts of infeasible relaxations are stronger.
+    mClock.start();
+    double residualTime = mInputParameters->MIPSolver.TimeLimit - this->getDoubleInfo(GRB_CB_RUNTIME);
+    const std::vector<CPRaceEntry> entries = {
+        {PackingType::Complete,
+         subtour.CustomersInRoute,
+         mInputParameters->IsExact(Exact),
+         mInputParameters->DetermineMaxRuntime(Exact, residualTime),
+         false,
+         true},
+        {PackingType::LifoNoSequence,
+         subtour.CustomersInRoute,
+         mInputParameters->IsExact(TwoPath),
+         mInputParameters->DetermineMaxRuntime(TwoPath)},
+        {PackingType::NoSupport,
+         boost::dynamic_bitset<>(),
+         mInputParameters->IsExact(RegularPath),
+         mInputParameters->DetermineMaxRuntime(RegularPath)}};
+
+    const auto statuses =
+        mLoadingChecker->RaceConstraintProgrammingSolvers(entries, container, subtour.Sequence, items);
+    const auto exactStatus = statuses[0];
+    const auto twoPathStatus = statuses[1];
+    const auto regularPathStatus = statuses[2];
+
+    switch (exactStatus)
+    {
+        case LoadingStatus::FeasOpt:
+            LocalSearch::RunIntraImprovement(mInstance, mLoadingChecker, mInputParameters, subtour.Sequence);
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::ExactFeas, mClock.elapsed());
+            return LoadingStatus::FeasOpt;
+        case LoadingStatus::Infeasible:
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::ExactInf, mClock.elapsed());
+            break;
+        case LoadingStatus::Invalid:
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::ExactInvalid, mClock.elapsed());
+            return LoadingStatus::Invalid;
+        case LoadingStatus::Unknown:
+            // Stopped by an infeasible relaxation or by the stop of the run.
+            mClock.end();
+            if (twoPathStatus == LoadingStatus::Infeasible || regularPathStatus == LoadingStatus::Infeasible)
+            {
                 break;
-            case LoadingStatus::Invalid:
-                mClock.end();
+            }
+
+            if (mLoadingChecker->GetStopToken().StopRequested())
+            {
                 CallbackTracker.UpdateElement(CallbackElement::ExactInvalid, mClock.elapsed());
                 return LoadingStatus::Invalid;
-            case LoadingStatus::Unknown:
-                mClock.end();
-                throw std::runtime_error("LoadingStatus is Unknown after exact CP model in CheckRouteExact().");
+            }
+
+            // Time limit with the shared workers reached -> lifting and exact model as without the portfolio.
+            CallbackTracker.UpdateElement(CallbackElement::ExactLimitUnk, mClock.elapsed());
+            if (Lifting(subtour, container, items))
+            {
+                return LoadingStatus::Infeasible;
+            }
+
+            return CheckRouteExactResidual(subtour, container, items);
+    }
+
+    // Infeasible relaxations are cached -> the cuts are created without solving again.
+    if (twoPathStatus == LoadingStatus::Infeasible)
+    {
+        mClock.start();
+        auto twoPathInequalities = mLazyConstraintsGenerator->TwoPathInequalityLifting(
+            subtour.Sequence, subtour.CustomersInRoute, container, items);
+        if (twoPathInequalities)
+        {
+            AddLazyConstraints(*twoPathInequalities);
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::TwoPathInequality, mClock.elapsed());
+
+            return LoadingStatus::Infeasible;
         }
     }
 
+    if (regularPathStatus == LoadingStatus::Infeasible)
+    {
+        mClock.start();
+        auto regularPathInequalities =
+            mLazyConstraintsGenerator->RegularPathLifting(subtour.Sequence, container, items);
+        if (regularPathInequalities)
+        {
+            AddLazyConstraints(*regularPathInequalities);
+            mClock.end();
+            CallbackTracker.UpdateElement(CallbackElement::RegularPathInequality, mClock.elapsed());
+
+            return LoadingStatus::Infeasible;
+        }
+    }
+
+    return AddInfeasibleRouteConstraints(subtour, container);
+}
+
+LoadingStatus SubtourCallback3DAll::AddInfeasibleRouteConstraints(const Subtour& subtour, Container& container)
+{
     mClock.start();
     AddLazyConstraints({mLazyConstraintsGenerator->CreateConstraint(CutType::TailTournament, subtour.Sequence)});
     mClock.end();
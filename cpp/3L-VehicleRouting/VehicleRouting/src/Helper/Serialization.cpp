@@ -50,6 +50,12 @@ NLOHMANN_JSON_SERIALIZE_ENUM(CallbackElement,
                               {CallbackElement::AddFracSolCuts, "AddFracSolCuts"},
                               {CallbackElement::BuildGraph, "BuildGraph"},
                               {CallbackElement::InfeasibleTailPathInequality, "InfTailPath"},
+                              {CallbackElement::BoundCheck, "BoundCheck"},
+                              {CallbackElement::BoundItemDimensions, "BoundItemDim"},
+                              {CallbackElement::BoundLargeItems, "BoundLargeItems"},
+                              {CallbackElement::BoundDualFeasible, "BoundDFF"},
+                              {CallbackElement::BoundFloorArea, "BoundFloorArea"},
+                              {CallbackElement::BoundCumulative, "BoundCumulative"},
                               {CallbackElement::SPHeuristic, "SPHeur"}});
 
 NLOHMANN_JSON_SERIALIZE_ENUM(CutType,
@@ -119,15 +125,23 @@ void from_json(const json& j, CPSolverParams& params)
     j.at("LogFlag").get_to(params.LogFlag);
     j.at("Threads").get_to(params.Threads);
     j.at("Seed").get_to(params.Seed);
+    params.EnableSymmetryBreaking = j.value("EnableSymmetryBreaking", params.EnableSymmetryBreaking);
+    params.ReusableModels = j.value("ReusableModels", params.ReusableModels);
+    params.ParallelPatternItems = j.value("ParallelPatternItems", params.ParallelPatternItems);
+    params.EnableDimensionScaling = j.value("EnableDimensionScaling", params.EnableDimensionScaling);
 }
 
 void to_json(json& j, const CPSolverParams& params)
 {
     j = json{{"EnableCumulativeDimensions", params.EnableCumulativeDimensions},
              {"EnableNoOverlap2DFloor", params.EnableNoOverlap2DFloor},
+             {"EnableSymmetryBreaking", params.EnableSymmetryBreaking},
              {"LogFlag", params.LogFlag},
              {"Threads", params.Threads},
-             {"Seed", params.Seed}};
+             {"Seed", params.Seed},
+             {"ReusableModels", params.ReusableModels},
+             {"ParallelPatternItems", params.ParallelPatternItems},
+             {"EnableDimensionScaling", params.EnableDimensionScaling}};
 }
 
 }
@@ -135,6 +149,61 @@ void to_json(json& j, const CPSolverParams& params)
 
 namespace ContainerLoading
 {
+NLOHMANN_JSON_SERIALIZE_ENUM(CacheLookup,
+                             {{CacheLookup::FeasibleSequence, "FeasibleSequence"},
+                              {CacheLookup::InfeasibleSequence, "InfeasibleSequence"},
+                              {CacheLookup::UnknownSequence, "UnknownSequence"},
+                              {CacheLookup::FeasibleSupersequence, "FeasibleSupersequence"},
+                              {CacheLookup::InfeasibleSubsequence, "InfeasibleSubsequence"},
+                              {CacheLookup::FeasibleSet, "FeasibleSet"},
+                              {CacheLookup::InfeasibleSet, "InfeasibleSet"},
+                              {CacheLookup::UnknownSet, "UnknownSet"},
+                              {CacheLookup::HeuristicInfeasibleSequence, "HeuristicInfeasibleSequence"},
+                              {CacheLookup::TwoOptCheckedSequence, "TwoOptCheckedSequence"}});
+
+void to_json(json& j, const CacheLookupStatistics& statistics)
+{
+    j = json{{"Mask", static_cast<int>(statistics.Mask)},
+             {"Lookup", statistics.Lookup},
+             {"Hits", statistics.Hits},
+             {"Misses", statistics.Misses},
+             {"LookupTime", statistics.LookupTime},
+             {"EstimatedSavedTime", statistics.EstimatedSavedTime}};
+}
+
+void to_json(json& j, const CPSolveStatistics& statistics)
+{
+    j = json{{"Mask", static_cast<int>(statistics.Mask)}, {"Calls", statistics.Calls}, {"Time", statistics.Time}};
+}
+
+void from_json(const json& j, LoadingCacheParams& params)
+{
+    params.MaxMemoryUnknown = j.value("MaxMemoryUnknown", params.MaxMemoryUnknown);
+    params.MaxMemoryTwoOptChecked = j.value("MaxMemoryTwoOptChecked", params.MaxMemoryTwoOptChecked);
+    params.MaxMemoryHeuristicInfeasible = j.value("MaxMemoryHeuristicInfeasible", params.MaxMemoryHeuristicInfeasible);
+    params.MaxMemoryPlacementPatterns = j.value("MaxMemoryPlacementPatterns", params.MaxMemoryPlacementPatterns);
+    params.UnknownEscalationFactor = j.value("UnknownEscalationFactor", params.UnknownEscalationFactor);
+    params.MaxTotalTimeUnknown = j.value("MaxTotalTimeUnknown", params.MaxTotalTimeUnknown);
+}
+
+void to_json(json& j, const LoadingCacheParams& params)
+{
+    j = json{{"MaxMemoryUnknown", params.MaxMemoryUnknown},
+             {"MaxMemoryTwoOptChecked", params.MaxMemoryTwoOptChecked},
+             {"MaxMemoryHeuristicInfeasible", params.MaxMemoryHeuristicInfeasible},
+             {"MaxMemoryPlacementPatterns", params.MaxMemoryPlacementPatterns},
+             {"UnknownEscalationFactor", params.UnknownEscalationFactor},
+             {"MaxTotalTimeUnknown", params.MaxTotalTimeUnknown}};
+}
+
+void to_json(json& j, const LoadingCacheStatistics& statistics)
+{
+    j = json{{"Name", statistics.Name},
+             {"Entries", statistics.Entries},
+             {"MemoryUsage", statistics.MemoryUsage},
+             {"Evictions", statistics.Evictions}};
+}
+
 void from_json(const json& j, LoadingProblemParams& params)
 {
     j.at("ProblemVariant").get_to(params.Variant);
@@ -191,6 +260,8 @@ void from_json(const json& j, BranchAndCutParams& params)
     j.at("ActivateHeuristic").get_to(params.ActivateHeuristic);
     j.at("ActivateMemoryManagement").get_to(params.ActivateMemoryManagement);
     j.at("SimpleVersion").get_to(params.SimpleVersion);
+    params.EnableInfeasibleCores = j.value("EnableInfeasibleCores", params.EnableInfeasibleCores);
+    params.EnableLoadingPortfolio = j.value("EnableLoadingPortfolio", params.EnableLoadingPortfolio);
 }
 
 void to_json(json& j, const BranchAndCutParams& params)
@@ -208,7 +279,9 @@ void to_json(json& j, const BranchAndCutParams& params)
              {"TimeLimit", params.TimeLimits},
              {"ActivateHeuristic", params.ActivateHeuristic},
              {"ActivateMemoryManagement", params.ActivateMemoryManagement},
-             {"SimpleVersion", params.SimpleVersion}};
+             {"SimpleVersion", params.SimpleVersion},
+             {"EnableInfeasibleCores", params.EnableInfeasibleCores},
+             {"EnableLoadingPortfolio", params.EnableLoadingPortfolio}};
 }
 
 void from_json(const json& j, UserCutParams& params)
@@ -236,6 +309,10 @@ void from_json(const json& j, InputParameters& inputParameters)
     j.at("BranchAndCutParams").get_to(inputParameters.BranchAndCut);
     j.at("UserCutParams").get_to(inputParameters.UserCut);
     j.at("CPSolverParams").get_to(inputParameters.ContainerLoading.CPSolver);
+    if (j.contains("LoadingCacheParams"))
+    {
+        j.at("LoadingCacheParams").get_to(inputParameters.ContainerLoading.LoadingCache);
+    }
 }
 
 void to_json(json& j, const InputParameters& inputParameters)
@@ -244,7 +321,8 @@ void to_json(json& j, const InputParameters& inputParameters)
              {"MIPSolverParams", inputParameters.MIPSolver},
              {"BranchAndCutParams", inputParameters.BranchAndCut},
              {"UserCutParams", inputParameters.UserCut},
-             {"CPSolverParams", inputParameters.ContainerLoading.CPSolver}};
+             {"CPSolverParams", inputParameters.ContainerLoading.CPSolver},
+             {"LoadingCacheParams", inputParameters.ContainerLoading.LoadingCache}};
 }
 
 }
@@ -315,6 +393,7 @@ void from_json(const json& j, Tour& tour)
     j.at("Depot").get_to<Node>(tour.Depot);
     j.at("Vehicle").get_to<Vehicle>(tour.Vehicle);
     j.at("Route").get_to<std::vector<Node>>(tour.Route);
+    tour.PackingVerified = j.value("PackingVerified", tour.PackingVerified);
 }
 
 void to_json(json& j, const Tour& tour)
@@ -323,6 +402,7 @@ void to_json(json& j, const Tour& tour)
         {"Depot", tour.Depot},
         {"Vehicle", tour.Vehicle},
         {"Route", tour.Route},
+        {"PackingVerified", tour.PackingVerified},
     };
 }
 
@@ -351,6 +431,9 @@ void to_json(json& j, const SolverStatistics& statistics)
         {"InfTailPath", statistics.InfeasibleTailPathStart},
         {"SubtourTracker", statistics.SubtourTracker},
         {"Timer", statistics.Timer},
+        {"LoadingCaches", statistics.LoadingCaches},
+        {"LoadingCacheLookups", statistics.LoadingCacheLookups},
+        {"LoadingSolves", statistics.LoadingSolves},
     };
 }
 